@@ -62,7 +62,7 @@
  * Default value: 10
  * It affects statically allocated RAM.
  */
-#define ANJ_DM_MAX_OBJECTS_NUMBER 4
+#define ANJ_DM_MAX_OBJECTS_NUMBER 9
 
 /**
  * Enable Composite Operations support (Read-Composite, Write-Composite)
@@ -304,7 +304,7 @@
 /**
  * Enable LwM2M Send operation in Information Reporting Interface.
  */
-/* #undef ANJ_WITH_LWM2M_SEND */
+#define ANJ_WITH_LWM2M_SEND
 
 /**
  * Configures the number of Send messages that can be queued simultaneously.
@@ -313,7 +313,7 @@
  * Default value: 1
  * It affects statically allocated RAM.
  */
-/* #undef ANJ_LWM2M_SEND_QUEUE_SIZE */
+#define ANJ_LWM2M_SEND_QUEUE_SIZE 1
 
 /******************************************************************************\
  * Compat layer configuration
@@ -386,7 +386,7 @@
  * This option is meaningful if underlaying, platform sockets implementation
  * supports TCP.
  */
-/* #undef ANJ_NET_WITH_TCP */
+#define ANJ_NET_WITH_TCP
 
 /**
  * Enable communication using DTLS protocol.
@@ -576,7 +576,7 @@
  *
  * Requires @ref ANJ_NET_WITH_TCP to be enabled.
  */
-/* #undef ANJ_COAP_WITH_TCP */
+#define ANJ_COAP_WITH_TCP
 
 /**
  * Configures the maximum allowed number of Options present in CoAP header, in a
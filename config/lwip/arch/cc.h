@@ -0,0 +1,35 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#ifndef LWIP_ARCH_CC_H
+#define LWIP_ARCH_CC_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <platform.h>
+
+// implemented in src/compat/lwip_port.c using the hardware RNG
+uint32_t lwip_port_rand(void);
+
+#define LWIP_RAND() ((u32_t) lwip_port_rand())
+
+#define LWIP_PLATFORM_DIAG(x) \
+    do {                      \
+        printf x;             \
+    } while (0)
+
+#define LWIP_PLATFORM_ASSERT(x)                                        \
+    do {                                                               \
+        printf("lwIP assertion \"%s\" failed at %s:%d\n", x, __FILE__, \
+               __LINE__);                                              \
+        Error_Handler();                                               \
+    } while (0)
+
+#endif // LWIP_ARCH_CC_H
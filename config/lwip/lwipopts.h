@@ -0,0 +1,65 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#ifndef LWIPOPTS_H
+#define LWIPOPTS_H
+
+/**
+ * @file lwipopts.h
+ *
+ * lwIP configuration used with CONFIG_NET_PPP. The stack runs in the main loop
+ * only (raw API, no OS), on top of a single PPP interface.
+ */
+
+#define NO_SYS 1
+#define SYS_LIGHTWEIGHT_PROT 0
+#define LWIP_SOCKET 0
+#define LWIP_NETCONN 0
+
+#define MEM_ALIGNMENT 4
+#define MEM_SIZE (8 * 1024)
+#define MEMP_NUM_PBUF 8
+#define MEMP_NUM_UDP_PCB 4
+#define MEMP_NUM_TCP_PCB 2
+#define MEMP_NUM_TCP_SEG 16
+#define PBUF_POOL_SIZE 8
+#define PBUF_POOL_BUFSIZE 592
+
+#define LWIP_IPV4 1
+#define LWIP_IPV6 1
+#define LWIP_ICMP 1
+#define LWIP_UDP 1
+#define LWIP_TCP 1
+#define LWIP_DNS 1
+#define LWIP_DHCP 0
+#define LWIP_AUTOIP 0
+#define LWIP_ARP 0
+#define LWIP_ETHERNET 0
+#define LWIP_IPV6_MLD 0
+#define LWIP_IPV6_AUTOCONFIG 1
+
+#define TCP_MSS 536
+#define TCP_WND (2 * TCP_MSS)
+#define TCP_SND_BUF (2 * TCP_MSS)
+#define TCP_SND_QUEUELEN (4 * TCP_SND_BUF / TCP_MSS)
+
+#define PPP_SUPPORT 1
+#define PPPOS_SUPPORT 1
+#define PPP_IPV4_SUPPORT 1
+#define PPP_IPV6_SUPPORT LWIP_IPV6
+#define PAP_SUPPORT 1
+#define CHAP_SUPPORT 1
+// received data is fed from the main loop, not from the UART interrupt
+#define PPP_INPROC_IRQ_SAFE 0
+
+#define LWIP_CHKSUM_ALGORITHM 3
+#define LWIP_STATS 0
+#define LWIP_NETIF_HOSTNAME 0
+
+#endif // LWIPOPTS_H
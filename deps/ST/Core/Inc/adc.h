@@ -35,6 +35,14 @@ extern "C" {
 extern ADC_HandleTypeDef hadc1;
 
 /* USER CODE BEGIN Private defines */
+/* Hardware oversampling of the regular group: each conversion result is the
+ * sum of RATIO samples shifted right by SHIFT bits. */
+#ifndef CONFIG_ADC_OVERSAMPLING_RATIO
+#define CONFIG_ADC_OVERSAMPLING_RATIO 8
+#endif
+#ifndef CONFIG_ADC_OVERSAMPLING_SHIFT
+#define CONFIG_ADC_OVERSAMPLING_SHIFT 0
+#endif
 
 /* USER CODE END Private defines */
 
@@ -39,7 +39,7 @@
 /*#define HAL_CCB_MODULE_ENABLED */
 /*#define HAL_COMP_MODULE_ENABLED */
 /*#define HAL_CRC_MODULE_ENABLED */
-/*#define HAL_CRYP_MODULE_ENABLED */
+#define HAL_CRYP_MODULE_ENABLED
 /*#define HAL_DAC_MODULE_ENABLED */
 /*#define HAL_DMA_MODULE_ENABLED */
 /*#define HAL_FDCAN_MODULE_ENABLED */
@@ -59,7 +59,7 @@ void EXTI13_IRQHandler(void);
 void GPDMA1_Channel0_IRQHandler(void);
 void LPUART1_IRQHandler(void);
 /* USER CODE BEGIN EFP */
-
+void ADC1_IRQHandler(void);
 /* USER CODE END EFP */
 
 #ifdef __cplusplus
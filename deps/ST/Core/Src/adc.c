@@ -86,6 +86,14 @@ void MX_ADC1_Init(void)
     Error_Handler();
   }
   /* USER CODE BEGIN ADC1_Init 2 */
+  /* Ratio and shift come from the build configuration, so oversampling is set
+   * up here rather than in the generated code above */
+  LL_ADC_ConfigOverSamplingRatioShift(hadc1.Instance,
+                                      CONFIG_ADC_OVERSAMPLING_RATIO,
+                                      CONFIG_ADC_OVERSAMPLING_SHIFT
+                                          << ADC_CFGR2_OVSS_Pos);
+  LL_ADC_SetOverSamplingScope(hadc1.Instance,
+                              LL_ADC_OVS_GRP_REGULAR_CONTINUED);
 
   /* USER CODE END ADC1_Init 2 */
 
@@ -172,7 +180,9 @@ void HAL_ADC_MspInit(ADC_HandleTypeDef* adcHandle)
     }
 
   /* USER CODE BEGIN ADC1_MspInit 1 */
-
+    /* ADC1 interrupt Init, for the analog watchdog */
+    HAL_NVIC_SetPriority(ADC1_IRQn, 12, 0);
+    HAL_NVIC_EnableIRQ(ADC1_IRQn);
   /* USER CODE END ADC1_MspInit 1 */
   }
 }
@@ -191,7 +201,7 @@ void HAL_ADC_MspDeInit(ADC_HandleTypeDef* adcHandle)
     /* ADC1 DMA DeInit */
     HAL_DMA_DeInit(adcHandle->DMA_Handle);
   /* USER CODE BEGIN ADC1_MspDeInit 1 */
-
+    HAL_NVIC_DisableIRQ(ADC1_IRQn);
   /* USER CODE END ADC1_MspDeInit 1 */
   }
 }
@@ -40,10 +40,14 @@ void SystemClock_Config(void) {
 
     /** Initializes the CPU, AHB and APB buses clocks
      */
-    RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_MSIS;
+    RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_MSIS
+                                       | RCC_OSCILLATORTYPE_HSI;
     RCC_OscInitStruct.MSISState = RCC_MSI_ON;
     RCC_OscInitStruct.MSISSource = RCC_MSI_RC0;
     RCC_OscInitStruct.MSISDiv = RCC_MSI_DIV1;
+    // HSI16 is the LPUART1 kernel clock, as it can run in Stop mode
+    RCC_OscInitStruct.HSIState = RCC_HSI_ON;
+    RCC_OscInitStruct.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
     if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK) {
         Error_Handler();
     }
@@ -0,0 +1,380 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <anj/log.h>
+#include <anj/utils.h>
+
+#include <adc.h>
+#include <stm32u3xx_hal.h>
+#include <stm32u3xx_ll_adc.h>
+
+#include "power.h"
+#include "timebase.h"
+
+#include "adc_scan.h"
+
+#define adc_log(...) anj_log(adc_scan, __VA_ARGS__)
+
+static const uint32_t CHANNELS[] = {
+    [ADC_SCAN_VREFINT] = ADC_CHANNEL_VREFINT,
+    [ADC_SCAN_TEMPSENSOR] = ADC_CHANNEL_TEMPSENSOR,
+    [ADC_SCAN_VBAT] = ADC_CHANNEL_VBAT,
+#ifdef ADC_SCAN_HAVE_EXT
+    [ADC_SCAN_EXT] = CONFIG_ADC_EXT_CHANNEL,
+#endif // ADC_SCAN_HAVE_EXT
+};
+
+ANJ_STATIC_ASSERT(ANJ_ARRAY_SIZE(CHANNELS) == _ADC_SCAN_CHANNEL_COUNT,
+                  adc_scan_channels_mismatch);
+
+// channels are converted in the order of the table above
+static const uint32_t RANKS[] = {
+    ADC_REGULAR_RANK_1, ADC_REGULAR_RANK_2, ADC_REGULAR_RANK_3,
+    ADC_REGULAR_RANK_4, ADC_REGULAR_RANK_5, ADC_REGULAR_RANK_6
+};
+
+ANJ_STATIC_ASSERT(_ADC_SCAN_CHANNEL_COUNT <= ANJ_ARRAY_SIZE(RANKS),
+                  adc_scan_too_many_channels);
+
+// a burst takes a few milliseconds
+#define ADC_BURST_TIMEOUT_US (50 * 1000ULL)
+
+/**
+ * Buffer for ADC DMA
+ *
+ * The ADC is configured in continuous conversion mode with automatic DMA
+ * requests, and converts the channels of the scan sequence in a loop. Each
+ * conversion result is already an average of CONFIG_ADC_OVERSAMPLING_RATIO
+ * samples made by the hardware oversampler. The DMA writes halfwords, so every
+ * row of the buffer holds one round of the sequence; a burst fills the buffer
+ * once.
+ */
+#define ADC_BUFF_SAMPLES 16
+static uint16_t adc_dma_buff[ADC_BUFF_SAMPLES][_ADC_SCAN_CHANNEL_COUNT]
+        __attribute__((aligned(4)));
+
+// samples are processed as signed 16-bit SIMD lanes
+ANJ_STATIC_ASSERT(ADC_OVERSAMPLED_MAX <= INT16_MAX,
+                  adc_oversampled_value_too_large);
+ANJ_STATIC_ASSERT(ADC_BUFF_SAMPLES % 2 == 0, adc_buff_samples_not_even);
+// shifting by more than the ratio would only throw away resolution
+ANJ_STATIC_ASSERT(CONFIG_ADC_OVERSAMPLING_RATIO
+                          >= (1 << CONFIG_ADC_OVERSAMPLING_SHIFT),
+                  adc_oversampling_shift_too_large);
+
+// weight of a new value in the IIR filter, in Q15 format; with samples every
+// second this gives a time constant of about 4 seconds
+#define FILTER_ALPHA_Q15 (32768 / 4)
+// samples further apart restart the filter, they would only add lag
+#define FILTER_RESTART_AGE_US (4 * 1000 * 1000ULL)
+#define FILTER_COEFFS            \
+    ((uint32_t) FILTER_ALPHA_Q15 \
+     | ((uint32_t) (32768 - FILTER_ALPHA_Q15) << 16))
+
+static uint16_t adc_filtered[_ADC_SCAN_CHANNEL_COUNT];
+
+// calibration factor, lost in deep power down and restored on power up
+static uint32_t adc_calibration_factor;
+static bool adc_powered;
+static volatile bool adc_burst_done;
+static volatile bool adc_alarm;
+
+static bool burst_in_progress;
+static uint64_t burst_deadline_us;
+// a burst started because of a crossing restarts the filter, so that it
+// either confirms or dismisses the crossing right away
+static bool restart_filter;
+static bool watching;
+// time of the latest completed burst, 0 before the first one
+static uint64_t sample_time_us;
+
+/**
+ * Averages the samples of @p channel in the DMA buffer. Two rows are processed
+ * at a time: both samples are packed into a single word and accumulated with
+ * a dual 16-bit multiply-accumulate instruction.
+ */
+static uint16_t average_samples(adc_scan_channel_t channel) {
+    uint32_t sum = 0;
+    for (size_t i = 0; i < ADC_BUFF_SAMPLES; i += 2) {
+        sum = __SMLAD(__PKHBT(adc_dma_buff[i][channel],
+                              adc_dma_buff[i + 1][channel], 16),
+                      0x00010001, sum);
+    }
+    return (uint16_t) (sum / ADC_BUFF_SAMPLES);
+}
+
+/**
+ * First-order IIR low-pass filter, y += alpha * (x - y), computed for each
+ * channel as a single dual multiply-accumulate of the (x, y) pair with the
+ * (alpha, 1 - alpha) coefficients.
+ */
+static void filter_samples(bool restart) {
+    for (size_t i = 0; i < _ADC_SCAN_CHANNEL_COUNT; i++) {
+        uint16_t average = average_samples((adc_scan_channel_t) i);
+        if (restart) {
+            adc_filtered[i] = average;
+            continue;
+        }
+        uint32_t pair = __PKHBT(average, adc_filtered[i], 16);
+        adc_filtered[i] =
+                (uint16_t) (__SMLAD(pair, FILTER_COEFFS, 1 << 14) >> 15);
+    }
+}
+
+static void wait_us(uint32_t us) {
+    // NOTE: rounded up by one tick of the time base, which runs at 32 kHz
+    uint64_t deadline = timebase_now_us() + us + 32;
+    while (timebase_now_us() < deadline) {
+    }
+}
+
+static void adc_power_up(void) {
+    if (adc_powered) {
+        return;
+    }
+    // the ADC doesn't run in Stop 2
+    power_hold_stop2(true);
+    __HAL_RCC_ADC12_CLK_ENABLE();
+    LL_ADC_DisableDeepPowerDown(hadc1.Instance);
+    LL_ADC_EnableInternalRegulator(hadc1.Instance);
+    wait_us(LL_ADC_DELAY_INTERNAL_REGUL_STAB_US);
+    HAL_ADCEx_Calibration_SetValue(&hadc1, ADC_SINGLE_ENDED,
+                                   adc_calibration_factor);
+    // NOTE: the VBAT bridge draws current from the battery, it's only enabled
+    // together with the rest of the ADC
+    LL_ADC_SetCommonPathInternalCh(__LL_ADC_COMMON_INSTANCE(hadc1.Instance),
+                                   LL_ADC_PATH_INTERNAL_VREFINT
+                                           | LL_ADC_PATH_INTERNAL_TEMPSENSOR
+                                           | LL_ADC_PATH_INTERNAL_VBAT);
+    wait_us(LL_ADC_DELAY_TEMPSENSOR_STAB_US);
+    adc_powered = true;
+}
+
+void adc_scan_power_down(void) {
+    if (!adc_powered) {
+        return;
+    }
+    if (watching) {
+        HAL_ADC_Stop(&hadc1);
+        watching = false;
+    }
+    LL_ADC_SetCommonPathInternalCh(__LL_ADC_COMMON_INSTANCE(hadc1.Instance),
+                                   LL_ADC_PATH_INTERNAL_NONE);
+    LL_ADC_DisableInternalRegulator(hadc1.Instance);
+    LL_ADC_EnableDeepPowerDown(hadc1.Instance);
+    __HAL_RCC_ADC12_CLK_DISABLE();
+    power_hold_stop2(false);
+    adc_powered = false;
+}
+
+void adc_scan_init(void) {
+#ifdef ADC_SCAN_HAVE_EXT
+    // NOTE: the GPIO port clock is expected to be enabled by MX_GPIO_Init()
+    GPIO_InitTypeDef gpio_init = {
+        .Pin = CONFIG_ADC_EXT_PIN,
+        .Mode = GPIO_MODE_ANALOG,
+        .Pull = GPIO_NOPULL
+    };
+    HAL_GPIO_Init(CONFIG_ADC_EXT_PORT, &gpio_init);
+#endif // ADC_SCAN_HAVE_EXT
+
+    // NOTE: MX_ADC1_Init() only configures the first two ranks, which are the
+    // same as here; the sequence is extended to all channels of the table
+    for (size_t i = 0; i < _ADC_SCAN_CHANNEL_COUNT; i++) {
+        ADC_ChannelConfTypeDef config = {
+            .Channel = CHANNELS[i],
+            .Rank = RANKS[i],
+            .SamplingTime = ADC_SAMPLETIME_246CYCLES_5,
+            .OffsetNumber = ADC_OFFSET_NONE
+        };
+        if (HAL_ADC_ConfigChannel(&hadc1, &config) != HAL_OK) {
+            adc_log(L_ERROR, "Failed to configure ADC rank %u",
+                    (unsigned) i + 1);
+        }
+    }
+    hadc1.Init.NbrOfConversion = _ADC_SCAN_CHANNEL_COUNT;
+    LL_ADC_REG_SetSequencerLength(hadc1.Instance,
+                                  (_ADC_SCAN_CHANNEL_COUNT - 1)
+                                          << ADC_SQR1_L_Pos);
+
+    HAL_ADCEx_Calibration_Start(&hadc1, ADC_SINGLE_ENDED);
+    adc_calibration_factor =
+            HAL_ADCEx_Calibration_GetValue(&hadc1, ADC_SINGLE_ENDED);
+    // MX_ADC1_Init() left the ADC powered, without holding Stop 2
+    power_hold_stop2(true);
+    adc_powered = true;
+    adc_scan_power_down();
+}
+
+void adc_scan_start(void) {
+    adc_power_up();
+    if (watching) {
+        HAL_ADC_Stop(&hadc1);
+        watching = false;
+    }
+    // undo adc_scan_watch()
+    LL_ADC_SetAnalogWDMonitChannels(hadc1.Instance, LL_ADC_AWD1,
+                                    LL_ADC_AWD_DISABLE);
+    LL_ADC_DisableIT_AWD1(hadc1.Instance);
+    LL_ADC_REG_SetOverrun(hadc1.Instance, LL_ADC_REG_OVR_DATA_PRESERVED);
+    LL_ADC_SetOverSamplingScope(hadc1.Instance,
+                                LL_ADC_OVS_GRP_REGULAR_CONTINUED);
+
+    restart_filter = adc_alarm;
+    adc_alarm = false;
+    adc_burst_done = false;
+    HAL_ADC_Start_DMA(&hadc1, (uint32_t *) adc_dma_buff,
+                      ADC_BUFF_SAMPLES * _ADC_SCAN_CHANNEL_COUNT);
+    // only the end of the burst is of interest
+    __HAL_DMA_DISABLE_IT(hadc1.DMA_Handle, DMA_IT_HT);
+    burst_in_progress = true;
+    burst_deadline_us = timebase_now_us() + ADC_BURST_TIMEOUT_US;
+}
+
+bool adc_scan_in_progress(void) {
+    return burst_in_progress;
+}
+
+bool adc_scan_ready(void) {
+    return adc_burst_done || timebase_now_us() >= burst_deadline_us;
+}
+
+uint64_t adc_scan_deadline_us(void) {
+    return burst_deadline_us;
+}
+
+bool adc_scan_finish(void) {
+    bool done = adc_burst_done;
+    HAL_ADC_Stop_DMA(&hadc1);
+    burst_in_progress = false;
+    if (!done) {
+        adc_log(L_WARNING, "ADC burst timed out");
+        return false;
+    }
+
+    uint64_t now = timebase_now_us();
+    filter_samples(!sample_time_us || restart_filter
+                   || now - sample_time_us >= FILTER_RESTART_AGE_US);
+    sample_time_us = now;
+    return true;
+}
+
+uint16_t adc_scan_value(adc_scan_channel_t channel) {
+    return adc_filtered[channel];
+}
+
+uint64_t adc_scan_time_us(void) {
+    return sample_time_us;
+}
+
+// full scale of the oversampled readings, in single conversions
+static double oversampling_gain(void) {
+    return (double) CONFIG_ADC_OVERSAMPLING_RATIO
+           / (1 << CONFIG_ADC_OVERSAMPLING_SHIFT);
+}
+
+/**
+ * The internal reference was calibrated at VREFINT_CAL_VREF, so the analog
+ * supply voltage is:
+ *
+ *   VDDA = VREFINT_CAL_VREF * VREFINT_CAL / vref_raw
+ *
+ * with vref_raw in single conversions; any other channel reads
+ * VDDA * raw / ADC_CONVERSION_MAX.
+ */
+double adc_scan_vdda(void) {
+    uint16_t vref = adc_filtered[ADC_SCAN_VREFINT];
+    if (!vref) {
+        return 0.0;
+    }
+    return (double) VREFINT_CAL_VREF * (*VREFINT_CAL_ADDR)
+           * oversampling_gain() / vref / 1000.0;
+}
+
+double adc_scan_voltage(adc_scan_channel_t channel) {
+    return adc_scan_vdda() * adc_filtered[channel]
+           / (ADC_CONVERSION_MAX * oversampling_gain());
+}
+
+double adc_scan_voltage_to_value(double voltage) {
+    double vdda = adc_scan_vdda();
+    if (!vdda) {
+        return 0.0;
+    }
+    return voltage / vdda * ADC_CONVERSION_MAX * oversampling_gain();
+}
+
+/**
+ * Keeps the ADC converting the scan sequence with the analog watchdog on one
+ * channel, and nothing else: the results are not transferred anywhere and the
+ * CPU sleeps until the reading leaves the window.
+ *
+ * The oversampler is bypassed, so that the thresholds don't depend on where
+ * the watchdog taps the data; instead, the watchdog only fires after a few
+ * consecutive conversions out of the window.
+ */
+bool adc_scan_watch(adc_scan_channel_t channel, double low, double high) {
+    // NOTE: the window is rounded inwards, a crossing may be signalled a bit
+    // early and then dismissed by the sample it triggers, but is never missed
+    double raw_low = fmax(ceil(low / oversampling_gain()), 0);
+    double raw_high =
+            fmin(floor(high / oversampling_gain()), ADC_CONVERSION_MAX);
+    if (raw_low > raw_high) {
+        // thresholds closer together than the resolution of a conversion
+        adc_scan_power_down();
+        return false;
+    }
+    adc_power_up();
+    if (watching) {
+        HAL_ADC_Stop(&hadc1);
+    }
+    LL_ADC_SetOverSamplingScope(hadc1.Instance, LL_ADC_OVS_DISABLE);
+    LL_ADC_REG_SetOverrun(hadc1.Instance, LL_ADC_REG_OVR_DATA_OVERWRITTEN);
+    ADC_AnalogWDGConfTypeDef config = {
+        .WatchdogNumber = ADC_ANALOGWATCHDOG_1,
+        .WatchdogMode = ADC_ANALOGWATCHDOG_SINGLE_REG,
+        .Channel = CHANNELS[channel],
+        .ITMode = ENABLE,
+        .HighThreshold = (uint32_t) raw_high,
+        .LowThreshold = (uint32_t) raw_low,
+        .FilteringConfig = ADC_AWD_FILTERING_4SAMPLES
+    };
+    adc_alarm = false;
+    HAL_ADC_AnalogWDGConfig(&hadc1, &config);
+    HAL_ADC_Start(&hadc1);
+    watching = true;
+    return true;
+}
+
+bool adc_scan_alarm(void) {
+    return adc_alarm;
+}
+
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc) {
+    if (hadc == &hadc1) {
+        // the DMA is circular, the conversions would otherwise go on; the rest
+        // of the power down is done by the main loop
+        LL_ADC_REG_StopConversion(hadc->Instance);
+        adc_burst_done = true;
+    }
+}
+
+void HAL_ADC_LevelOutOfWindowCallback(ADC_HandleTypeDef *hadc) {
+    if (hadc == &hadc1) {
+        // the reading stays out of the window until the main loop takes a
+        // sample and moves the window around it
+        LL_ADC_DisableIT_AWD1(hadc->Instance);
+        adc_alarm = true;
+    }
+}
@@ -0,0 +1,142 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#ifndef ADC_SCAN_H
+#define ADC_SCAN_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Sampling engine for ADC1. All channels below are converted by a single scan
+ * sequence, and a burst of a few rounds of the sequence is transferred with a
+ * single DMA sweep. The results of each channel are averaged and low-pass
+ * filtered, then the ADC is either powered down until the next burst, or left
+ * watching one channel with its analog watchdog.
+ *
+ * Adding a channel takes an entry here and in the channel table in
+ * adc_scan.c; the scan sequence and the DMA transfer follow.
+ */
+#if defined(CONFIG_ADC_EXT_CHANNEL) && defined(CONFIG_ADC_EXT_PORT) \
+        && defined(CONFIG_ADC_EXT_PIN)
+#    define ADC_SCAN_HAVE_EXT
+#endif // defined(CONFIG_ADC_EXT_CHANNEL) && defined(CONFIG_ADC_EXT_PORT) &&
+       // defined(CONFIG_ADC_EXT_PIN)
+
+typedef enum {
+    // internal voltage reference, all voltages are computed from it
+    ADC_SCAN_VREFINT,
+    ADC_SCAN_TEMPSENSOR,
+    // VBAT through the internal 1/4 divider
+    ADC_SCAN_VBAT,
+#ifdef ADC_SCAN_HAVE_EXT
+    // external pin, from the build configuration
+    ADC_SCAN_EXT,
+#endif // ADC_SCAN_HAVE_EXT
+    _ADC_SCAN_CHANNEL_COUNT
+} adc_scan_channel_t;
+
+// maximum value of a single conversion, and of an oversampled one
+#define ADC_CONVERSION_MAX 4095
+#define ADC_OVERSAMPLED_MAX                                 \
+    ((ADC_CONVERSION_MAX * CONFIG_ADC_OVERSAMPLING_RATIO) \
+     >> CONFIG_ADC_OVERSAMPLING_SHIFT)
+
+/**
+ * Calibrates the ADC and sets up the scan sequence. The ADC is left powered
+ * down.
+ */
+void adc_scan_init(void);
+
+/**
+ * Starts a burst, powering the ADC up if needed. Watching with the analog
+ * watchdog stops.
+ */
+void adc_scan_start(void);
+
+/**
+ * @returns true between @ref adc_scan_start and @ref adc_scan_finish.
+ */
+bool adc_scan_in_progress(void);
+
+/**
+ * @returns true if the burst in progress is complete or has timed out, i.e.
+ * @ref adc_scan_finish can be called.
+ */
+bool adc_scan_ready(void);
+
+/**
+ * Returns the time, as returned by @ref timebase_now_us, by which the burst in
+ * progress times out. The end of the burst is signalled by an interrupt, which
+ * wakes the CPU up earlier.
+ */
+uint64_t adc_scan_deadline_us(void);
+
+/**
+ * Stops the burst and, if it's complete, updates the filtered values of all
+ * channels. The ADC is left powered up, so that it can be handed over to
+ * @ref adc_scan_watch; otherwise call @ref adc_scan_power_down.
+ *
+ * @returns true if the values have been updated, false if the burst has timed
+ *          out.
+ */
+bool adc_scan_finish(void);
+
+/**
+ * Returns the filtered reading of @p channel, in the units of the oversampled
+ * conversions.
+ */
+uint16_t adc_scan_value(adc_scan_channel_t channel);
+
+/**
+ * Returns the time of the latest completed burst, 0 if there has been none.
+ */
+uint64_t adc_scan_time_us(void);
+
+/**
+ * Returns the analog supply voltage, in volts, computed from the VREFINT
+ * reading and its factory calibration.
+ */
+double adc_scan_vdda(void);
+
+/**
+ * Returns the voltage at the input of @p channel, in volts.
+ */
+double adc_scan_voltage(adc_scan_channel_t channel);
+
+/**
+ * Inverse of @ref adc_scan_voltage: returns the reading that @p voltage would
+ * give at the current analog supply voltage, in the units of
+ * @ref adc_scan_value.
+ */
+double adc_scan_voltage_to_value(double voltage);
+
+/**
+ * Keeps the ADC converting, with the analog watchdog on @p channel, until its
+ * reading leaves the [@p low, @p high] window, in the units of
+ * @ref adc_scan_value. The window is rounded inwards to the resolution of
+ * single conversions.
+ *
+ * @returns false if the window is empty at that resolution; the ADC is then
+ *          powered down instead.
+ */
+bool adc_scan_watch(adc_scan_channel_t channel, double low, double high);
+
+/**
+ * @returns true if the analog watchdog has fired since the last
+ *          @ref adc_scan_watch. It is not rearmed until the next one.
+ */
+bool adc_scan_alarm(void);
+
+/**
+ * Powers the ADC down. Must not be called with a burst in progress.
+ */
+void adc_scan_power_down(void);
+
+#endif // ADC_SCAN_H
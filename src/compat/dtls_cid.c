@@ -0,0 +1,82 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <anj/log.h>
+
+#include <mbedtls/ssl.h>
+
+#include "dtls_cid.h"
+
+#ifdef CONFIG_DTLS_CID
+
+#    define dtls_log(...) anj_log(dtls_cid, __VA_ARGS__)
+
+// SSL context of the DTLS session, NULL if there is none
+static mbedtls_ssl_context *dtls_ssl;
+
+// Anjay Lite sets up and releases its SSL contexts on its own, with no way to
+// configure the CID; the linker redirects the calls here, see CMakeLists.txt
+int __real_mbedtls_ssl_setup(mbedtls_ssl_context *ssl,
+                             const mbedtls_ssl_config *conf);
+int __real_mbedtls_ssl_session_reset(mbedtls_ssl_context *ssl);
+void __real_mbedtls_ssl_free(mbedtls_ssl_context *ssl);
+
+// NOTE: the request is repeated after a session reset, which is how a new
+// session is started over with the same SSL context
+static void request_cid(mbedtls_ssl_context *ssl) {
+    // fails for TLS, which has no use for a CID
+    if (!mbedtls_ssl_set_cid(ssl, MBEDTLS_SSL_CID_ENABLED, NULL, 0)) {
+        dtls_ssl = ssl;
+    } else if (dtls_ssl == ssl) {
+        dtls_ssl = NULL;
+    }
+}
+
+int __wrap_mbedtls_ssl_setup(mbedtls_ssl_context *ssl,
+                             const mbedtls_ssl_config *conf) {
+    int result = __real_mbedtls_ssl_setup(ssl, conf);
+    if (!result) {
+        request_cid(ssl);
+    }
+    return result;
+}
+
+int __wrap_mbedtls_ssl_session_reset(mbedtls_ssl_context *ssl) {
+    int result = __real_mbedtls_ssl_session_reset(ssl);
+    if (!result) {
+        request_cid(ssl);
+    }
+    return result;
+}
+
+void __wrap_mbedtls_ssl_free(mbedtls_ssl_context *ssl) {
+    if (ssl == dtls_ssl) {
+        dtls_ssl = NULL;
+    }
+    __real_mbedtls_ssl_free(ssl);
+}
+
+bool dtls_cid_in_use(void) {
+    int enabled;
+    // fails until the handshake is over
+    if (!dtls_ssl
+            || mbedtls_ssl_get_peer_cid(dtls_ssl, &enabled, NULL, NULL)) {
+        return false;
+    }
+    if (enabled != MBEDTLS_SSL_CID_ENABLED) {
+        dtls_log(L_DEBUG, "server did not agree to use a CID");
+        return false;
+    }
+    return true;
+}
+
+#endif // CONFIG_DTLS_CID
@@ -0,0 +1,33 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#ifndef DTLS_CID_H
+#define DTLS_CID_H
+
+#include <stdbool.h>
+
+/*
+ * DTLS Connection ID (RFC 9146) for the DTLS sessions set up by Anjay Lite.
+ * The client asks the server for a CID, which the server then uses to find
+ * the session instead of the source address and port of the records. The
+ * session thus survives NAT rebinding and a new socket, see net.c.
+ *
+ * The client's own CID is empty: records from the server arrive over the
+ * socket connected to it, so there is nothing to look up.
+ */
+
+#ifdef CONFIG_DTLS_CID
+/**
+ * @returns true if the current DTLS session is established and the server
+ *          has given a CID, i.e. its records may come from a new address.
+ */
+bool dtls_cid_in_use(void);
+#endif // CONFIG_DTLS_CID
+
+#endif // DTLS_CID_H
@@ -0,0 +1,35 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#include <stdint.h>
+
+#include <anj/log.h>
+
+#include <lwip/arch.h>
+#include <lwip/sys.h>
+
+#include <rng.h>
+#include <stm32u3xx_hal.h>
+
+// NOTE: the only parts of the lwIP glue that touch the hardware; the rest, in
+// net_ppp.c, is also built on the host, see tests/net_ppp_test.c
+
+#define net_log(...) anj_log(net, __VA_ARGS__)
+
+uint32_t lwip_port_rand(void) {
+    uint32_t random_number = 0;
+    if (HAL_RNG_GenerateRandomNumber(&hrng, &random_number) != HAL_OK) {
+        net_log(L_WARNING, "RNG failure");
+    }
+    return random_number;
+}
+
+u32_t sys_now(void) {
+    return HAL_GetTick();
+}
@@ -0,0 +1,210 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+/*
+ * AES block encryption on the AES peripheral, in place of the software
+ * implementation of mbed TLS, see MBEDTLS_AES_ENCRYPT_ALT in
+ * anj_client_mbedtls_config.h.
+ *
+ * DTLS records are protected with AES-CCM, which only ever uses the forward
+ * cipher: both the CBC-MAC and the CTR keystream are made of single block
+ * encryptions, issued by ccm.c through mbedtls_aes_crypt_ecb(). The same goes
+ * for CTR_DRBG. The key schedule and the inverse cipher stay in software.
+ *
+ * The peripheral is checked against the FIPS-197 known answers for both key
+ * sizes before the first block is encrypted. If that fails, an error is
+ * logged and all blocks are encrypted in software, see aes_sw.c.
+ */
+
+#define MBEDTLS_ALLOW_PRIVATE_ACCESS
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <anj/log.h>
+
+#include <mbedtls/aes.h>
+#include <mbedtls/error.h>
+#include <mbedtls/platform_util.h>
+
+#include <stm32u3xx_hal.h>
+
+#include "aes_sw.h"
+
+#ifdef MBEDTLS_AES_ENCRYPT_ALT
+
+#    define aes_log(...) anj_log(aes_alt, __VA_ARGS__)
+
+// a single block takes well under a microsecond
+#    define AES_TIMEOUT_MS 10
+
+#    define AES_BLOCK_SIZE 16
+#    define AES_MAX_KEY_WORDS 8
+
+static enum {
+    AES_UNTESTED,
+    AES_PASSED,
+    AES_FAILED
+} aes_status;
+
+static CRYP_HandleTypeDef hcryp;
+static bool hcryp_initialized;
+
+// key loaded into the peripheral, in its word order; HAL reads it on the
+// first block after each HAL_CRYP_SetConfig()
+static uint32_t loaded_key[AES_MAX_KEY_WORDS];
+static int loaded_nr;
+
+/**
+ * The original key makes the first words of the key schedule computed by
+ * mbedtls_aes_setkey_enc(), loaded as little endian words. The peripheral
+ * takes it as big endian words.
+ *
+ * The key is only reloaded when a different context is used: DTLS records of
+ * both directions and the DRBG interleave, but in bursts.
+ */
+static int load_key(const mbedtls_aes_context *ctx) {
+    size_t key_words;
+    uint32_t key_size;
+    switch (ctx->nr) {
+    case 10:
+        key_words = 4;
+        key_size = CRYP_KEYSIZE_128B;
+        break;
+    case 14:
+        key_words = 8;
+        key_size = CRYP_KEYSIZE_256B;
+        break;
+    default:
+        // the peripheral has no 192-bit mode, and no ciphersuite in use
+        // needs one
+        return MBEDTLS_ERR_PLATFORM_FEATURE_UNSUPPORTED;
+    }
+
+    const uint32_t *rk = ctx->buf + ctx->rk_offset;
+    uint32_t key[AES_MAX_KEY_WORDS];
+    for (size_t i = 0; i < key_words; i++) {
+        key[i] = __REV(rk[i]);
+    }
+    bool same_key = hcryp_initialized && ctx->nr == loaded_nr
+                    && !memcmp(key, loaded_key, key_words * sizeof(*key));
+    if (same_key) {
+        mbedtls_platform_zeroize(key, sizeof(key));
+        return 0;
+    }
+    memcpy(loaded_key, key, key_words * sizeof(*key));
+    mbedtls_platform_zeroize(key, sizeof(key));
+    loaded_nr = ctx->nr;
+
+    CRYP_ConfigTypeDef config = {
+        .DataType = CRYP_BYTE_SWAP,
+        .KeySize = key_size,
+        .pKey = loaded_key,
+        .Algorithm = CRYP_AES_ECB,
+        .DataWidthUnit = CRYP_DATAWIDTHUNIT_BYTE,
+        .KeyIVConfigSkip = CRYP_KEYIVCONFIG_ONCE
+    };
+    HAL_StatusTypeDef status;
+    if (!hcryp_initialized) {
+        __HAL_RCC_AES_CLK_ENABLE();
+        hcryp.Instance = AES;
+        hcryp.Init = config;
+        status = HAL_CRYP_Init(&hcryp);
+        hcryp_initialized = (status == HAL_OK);
+    } else {
+        status = HAL_CRYP_SetConfig(&hcryp, &config);
+    }
+    if (status != HAL_OK) {
+        // force a reload with the next block
+        loaded_nr = 0;
+        return MBEDTLS_ERR_PLATFORM_HW_ACCEL_FAILED;
+    }
+    return 0;
+}
+
+static int hw_encrypt(mbedtls_aes_context *ctx,
+                      const unsigned char input[16],
+                      unsigned char output[16]) {
+    int result = load_key(ctx);
+    if (result) {
+        return result;
+    }
+    // HAL accesses the data as words, the buffers of ccm.c are not aligned
+    uint32_t block[AES_BLOCK_SIZE / sizeof(uint32_t)];
+    memcpy(block, input, AES_BLOCK_SIZE);
+    if (HAL_CRYP_Encrypt(&hcryp, block, AES_BLOCK_SIZE, block, AES_TIMEOUT_MS)
+            != HAL_OK) {
+        loaded_nr = 0;
+        result = MBEDTLS_ERR_PLATFORM_HW_ACCEL_FAILED;
+    } else {
+        memcpy(output, block, AES_BLOCK_SIZE);
+    }
+    mbedtls_platform_zeroize(block, sizeof(block));
+    return result;
+}
+
+// FIPS-197 appendix C.1 and C.3
+static const unsigned char TEST_PLAINTEXT[AES_BLOCK_SIZE] = {
+    0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+    0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff
+};
+static const unsigned char TEST_KEY[32] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a,
+    0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15,
+    0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+};
+static const unsigned char TEST_CIPHERTEXT_128[AES_BLOCK_SIZE] = {
+    0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30,
+    0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a
+};
+static const unsigned char TEST_CIPHERTEXT_256[AES_BLOCK_SIZE] = {
+    0x8e, 0xa2, 0xb7, 0xca, 0x51, 0x67, 0x45, 0xbf,
+    0xea, 0xfc, 0x49, 0x90, 0x4b, 0x49, 0x60, 0x89
+};
+
+static bool test_block(unsigned key_bits, const unsigned char *expected) {
+    mbedtls_aes_context ctx;
+    unsigned char output[AES_BLOCK_SIZE];
+    mbedtls_aes_init(&ctx);
+    bool ok = !mbedtls_aes_setkey_enc(&ctx, TEST_KEY, key_bits)
+              && !hw_encrypt(&ctx, TEST_PLAINTEXT, output)
+              && !memcmp(output, expected, sizeof(output));
+    mbedtls_aes_free(&ctx);
+    return ok;
+}
+
+/**
+ * Both key sizes are checked, and the first one once more after the other, so
+ * that the key is reloaded in between.
+ */
+static bool self_test(void) {
+    return test_block(128, TEST_CIPHERTEXT_128)
+           && test_block(256, TEST_CIPHERTEXT_256)
+           && test_block(128, TEST_CIPHERTEXT_128);
+}
+
+int mbedtls_internal_aes_encrypt(mbedtls_aes_context *ctx,
+                                 const unsigned char input[16],
+                                 unsigned char output[16]) {
+    if (aes_status == AES_UNTESTED) {
+        aes_status = self_test() ? AES_PASSED : AES_FAILED;
+        if (aes_status == AES_FAILED) {
+            aes_log(L_ERROR,
+                    "AES peripheral failed the self-test, using software");
+        }
+    }
+    if (aes_status == AES_FAILED) {
+        return sw_mbedtls_internal_aes_encrypt(ctx, input, output);
+    }
+    return hw_encrypt(ctx, input, output);
+}
+
+#endif // MBEDTLS_AES_ENCRYPT_ALT
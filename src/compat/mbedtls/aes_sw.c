@@ -0,0 +1,49 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+/*
+ * The software AES implementation of mbed TLS, for aes_alt.c to fall back to.
+ * With MBEDTLS_AES_ENCRYPT_ALT, the block encryption is left out of the
+ * library, so aes.c is built here once more without it, with all of its
+ * functions renamed. The linker only keeps the ones that are called, i.e. the
+ * block encryption and the tables it uses.
+ */
+
+#include <mbedtls/build_info.h>
+
+#ifdef MBEDTLS_AES_ENCRYPT_ALT
+
+// NOTE: build_info.h is not included again, so this holds for aes.c
+#    undef MBEDTLS_AES_ENCRYPT_ALT
+
+#    define mbedtls_aes_init sw_mbedtls_aes_init
+#    define mbedtls_aes_free sw_mbedtls_aes_free
+#    define mbedtls_aes_xts_init sw_mbedtls_aes_xts_init
+#    define mbedtls_aes_xts_free sw_mbedtls_aes_xts_free
+#    define mbedtls_aes_setkey_enc sw_mbedtls_aes_setkey_enc
+#    define mbedtls_aes_setkey_dec sw_mbedtls_aes_setkey_dec
+#    define mbedtls_aes_xts_setkey_enc sw_mbedtls_aes_xts_setkey_enc
+#    define mbedtls_aes_xts_setkey_dec sw_mbedtls_aes_xts_setkey_dec
+#    define mbedtls_internal_aes_encrypt sw_mbedtls_internal_aes_encrypt
+#    define mbedtls_internal_aes_decrypt sw_mbedtls_internal_aes_decrypt
+#    define mbedtls_aes_crypt_ecb sw_mbedtls_aes_crypt_ecb
+#    define mbedtls_aes_crypt_cbc sw_mbedtls_aes_crypt_cbc
+#    define mbedtls_aes_crypt_xts sw_mbedtls_aes_crypt_xts
+#    define mbedtls_aes_crypt_cfb128 sw_mbedtls_aes_crypt_cfb128
+#    define mbedtls_aes_crypt_cfb8 sw_mbedtls_aes_crypt_cfb8
+#    define mbedtls_aes_crypt_ofb sw_mbedtls_aes_crypt_ofb
+#    define mbedtls_aes_crypt_ctr sw_mbedtls_aes_crypt_ctr
+#    define mbedtls_aes_self_test sw_mbedtls_aes_self_test
+
+#    include "../../../deps/mbedtls/library/aes.c"
+
+// checks the declaration used by aes_alt.c against the definition
+#    include "aes_sw.h"
+
+#endif // MBEDTLS_AES_ENCRYPT_ALT
@@ -0,0 +1,23 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#ifndef AES_SW_H
+#define AES_SW_H
+
+#include <mbedtls/aes.h>
+
+/**
+ * Software AES block encryption of mbed TLS, used by aes_alt.c if the AES
+ * peripheral fails its self-test, see aes_sw.c.
+ */
+int sw_mbedtls_internal_aes_encrypt(mbedtls_aes_context *ctx,
+                                    const unsigned char input[16],
+                                    unsigned char output[16]);
+
+#endif // AES_SW_H
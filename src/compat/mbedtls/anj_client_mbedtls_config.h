@@ -56,7 +56,11 @@
 #define MBEDTLS_SSL_PROTO_DTLS
 #define MBEDTLS_SSL_DTLS_ANTI_REPLAY
 #define MBEDTLS_SSL_DTLS_CLIENT_PORT_REUSE
+/* Requested for the sessions of Anjay Lite in dtls_cid.c */
 #define MBEDTLS_SSL_DTLS_CONNECTION_ID
+/* Stated explicitly (default values) as they are used for MTU calculations */
+#define MBEDTLS_SSL_CID_OUT_LEN_MAX 32
+#define MBEDTLS_SSL_CID_PADDING_GRANULARITY 16
 #define MBEDTLS_SSL_DTLS_HELLO_VERIFY
 #define MBEDTLS_SSL_MAX_FRAGMENT_LENGTH
 
@@ -73,11 +77,29 @@
  * The optimal size here depends on the typical size of records.
  */
 #define MBEDTLS_SSL_IN_CONTENT_LEN 512
-#define MBEDTLS_SSL_OUT_CONTENT_LEN 512
+/* Has to fit ANJ_OUT_MSG_BUFFER_SIZE, see src/compat/net_mtu.h */
+#define MBEDTLS_SSL_OUT_CONTENT_LEN 1200
 
 /* Save RAM at the expense of ROM */
 #define MBEDTLS_AES_ROM_TABLES
 
+/*
+ * Encrypt AES blocks on the AES peripheral, see aes_alt.c; this covers AES-CCM
+ * record protection and CTR_DRBG. The key schedule and decryption of single
+ * blocks, which neither of them uses, stay in software.
+ */
+#ifdef CONFIG_MBEDTLS_HW_AES
+#define MBEDTLS_AES_ENCRYPT_ALT
+#endif
+
+/*
+ * Compute SHA-256 on the HASH peripheral, see sha256_alt.c; this covers the
+ * handshake transcript and the HMACs of the PRF.
+ */
+#ifdef CONFIG_MBEDTLS_HW_SHA256
+#define MBEDTLS_SHA256_ALT
+#endif
+
 /* Save some RAM by adjusting to your exact needs */
 #define MBEDTLS_PSK_MAX_LEN 32 /* 256-bits keys are generally enough */
 
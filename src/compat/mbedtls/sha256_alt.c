@@ -0,0 +1,344 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+/*
+ * SHA-256 on the HASH peripheral, in place of the software implementation of
+ * mbed TLS, see MBEDTLS_SHA256_ALT in anj_client_mbedtls_config.h.
+ *
+ * The DTLS handshake keeps the transcript digest open while the PRF computes
+ * HMACs, so digests interleave. The peripheral holds one of them at a time:
+ * its context swap registers are saved in the mbed TLS context after each
+ * update, and restored when another context is used next. The HAL driver is
+ * not used, as its suspend/resume saves all of the 103 swap registers and
+ * tracks a single digest in its handle.
+ *
+ * The peripheral is checked against known answers and against interleaved
+ * digests when the first digest is started; if that fails, an error is logged
+ * and all digests are computed in software, see sha256_sw.c.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <anj/log.h>
+
+#include <mbedtls/error.h>
+#include <mbedtls/platform_util.h>
+#include <mbedtls/sha256.h>
+
+#include <stm32u3xx_hal.h>
+
+#include "sha256_sw.h"
+
+#ifdef MBEDTLS_SHA256_ALT
+
+#    define sha256_log(...) anj_log(sha256_alt, __VA_ARGS__)
+
+// a block takes well under a microsecond
+#    define HASH_TIMEOUT_MS 10
+
+#    define SHA224_DIGEST_WORDS 7
+#    define SHA256_DIGEST_WORDS 8
+
+#    define HASH_CR_SHA224 HASH_CR_ALGO_1
+#    define HASH_CR_SHA256 (HASH_CR_ALGO_0 | HASH_CR_ALGO_1)
+
+static enum {
+    HASH_UNTESTED,
+    HASH_PASSED,
+    HASH_FAILED
+} hash_status;
+
+// context whose state the peripheral holds, NULL if none
+static const mbedtls_sha256_context *loaded;
+
+static struct sw_mbedtls_sha256_context *sw_ctx(mbedtls_sha256_context *ctx) {
+    return (struct sw_mbedtls_sha256_context *) ctx->sw;
+}
+
+static uint32_t hash_cr(const mbedtls_sha256_context *ctx) {
+    // input bytes are taken in memory order
+    return (ctx->is224 ? HASH_CR_SHA224 : HASH_CR_SHA256) | HASH_CR_DATATYPE_1;
+}
+
+static int wait_status(uint32_t flag) {
+    uint32_t start = HAL_GetTick();
+    while ((HASH->SR & (flag | HASH_SR_BUSY)) != flag) {
+        if (HAL_GetTick() - start > HASH_TIMEOUT_MS) {
+            loaded = NULL;
+            return MBEDTLS_ERR_PLATFORM_HW_ACCEL_FAILED;
+        }
+    }
+    return 0;
+}
+
+static void load_context(const mbedtls_sha256_context *ctx) {
+    if (loaded == ctx) {
+        return;
+    }
+    HASH->IMR = 0;
+    HASH->STR = 0;
+    if (!ctx->started) {
+        HASH->CR = hash_cr(ctx) | HASH_CR_INIT;
+    } else {
+        // the swap registers are restored after INIT, see the reference
+        // manual on context swapping
+        HASH->CR = hash_cr(ctx);
+        HASH->CR |= HASH_CR_INIT;
+        for (size_t i = 0; i < SHA256_ALT_CSR_COUNT; i++) {
+            HASH->CSR[i] = ctx->csr[i];
+        }
+    }
+    loaded = ctx;
+}
+
+static void write_words(const unsigned char *input, size_t len) {
+    for (size_t i = 0; i < len; i += sizeof(uint32_t)) {
+        uint32_t word;
+        memcpy(&word, input + i, sizeof(word));
+        HASH->DIN = word;
+    }
+}
+
+/**
+ * Writes a block to the peripheral, @ref SHA256_ALT_FIRST_BLOCK_SIZE bytes if
+ * it's the first one, and waits until it's processed, which is when the
+ * context can be swapped.
+ */
+static int write_block(mbedtls_sha256_context *ctx,
+                       const unsigned char *input) {
+    load_context(ctx);
+    write_words(input, ctx->started ? SHA256_ALT_BLOCK_SIZE
+                                    : SHA256_ALT_FIRST_BLOCK_SIZE);
+    ctx->started = true;
+    return wait_status(HASH_SR_DINIS);
+}
+
+static void reset(mbedtls_sha256_context *ctx, int is224) {
+    if (loaded == ctx) {
+        loaded = NULL;
+    }
+    ctx->buffered = 0;
+    ctx->started = false;
+    ctx->is224 = is224;
+}
+
+static bool self_test(void);
+
+void mbedtls_sha256_init(mbedtls_sha256_context *ctx) {
+    if (loaded == ctx) {
+        loaded = NULL;
+    }
+    memset(ctx, 0, sizeof(*ctx));
+}
+
+void mbedtls_sha256_free(mbedtls_sha256_context *ctx) {
+    if (ctx == NULL) {
+        return;
+    }
+    if (loaded == ctx) {
+        loaded = NULL;
+    }
+    mbedtls_platform_zeroize(ctx, sizeof(*ctx));
+}
+
+void mbedtls_sha256_clone(mbedtls_sha256_context *dst,
+                          const mbedtls_sha256_context *src) {
+    if (loaded == dst) {
+        loaded = NULL;
+    }
+    *dst = *src;
+}
+
+int mbedtls_sha256_starts(mbedtls_sha256_context *ctx, int is224) {
+#    ifdef MBEDTLS_SHA224_C
+    if (is224 != 0 && is224 != 1) {
+        return MBEDTLS_ERR_SHA256_BAD_INPUT_DATA;
+    }
+#    else  // MBEDTLS_SHA224_C
+    if (is224 != 0) {
+        return MBEDTLS_ERR_SHA256_BAD_INPUT_DATA;
+    }
+#    endif // MBEDTLS_SHA224_C
+    if (hash_status == HASH_UNTESTED) {
+        __HAL_RCC_HASH_CLK_ENABLE();
+        hash_status = self_test() ? HASH_PASSED : HASH_FAILED;
+        if (hash_status == HASH_FAILED) {
+            sha256_log(L_ERROR,
+                       "HASH peripheral failed the self-test, using software");
+        }
+    }
+    ctx->software = (hash_status == HASH_FAILED);
+    if (ctx->software) {
+        sw_mbedtls_sha256_init(sw_ctx(ctx));
+        return sw_mbedtls_sha256_starts(sw_ctx(ctx), is224);
+    }
+    reset(ctx, is224);
+    return 0;
+}
+
+int mbedtls_sha256_update(mbedtls_sha256_context *ctx,
+                          const unsigned char *input,
+                          size_t ilen) {
+    if (ctx->software) {
+        return sw_mbedtls_sha256_update(sw_ctx(ctx), input, ilen);
+    }
+    bool written = false;
+    int result = 0;
+    while (ilen > 0 && !result) {
+        size_t block_size = ctx->started ? SHA256_ALT_BLOCK_SIZE
+                                         : SHA256_ALT_FIRST_BLOCK_SIZE;
+        if (!ctx->buffered && ilen >= block_size) {
+            result = write_block(ctx, input);
+            written = true;
+            input += block_size;
+            ilen -= block_size;
+            continue;
+        }
+        size_t fill = block_size - ctx->buffered;
+        if (fill > ilen) {
+            fill = ilen;
+        }
+        memcpy(ctx->buffer + ctx->buffered, input, fill);
+        ctx->buffered += fill;
+        input += fill;
+        ilen -= fill;
+        if (ctx->buffered == block_size) {
+            result = write_block(ctx, ctx->buffer);
+            written = true;
+            ctx->buffered = 0;
+        }
+    }
+    if (written && !result) {
+        for (size_t i = 0; i < SHA256_ALT_CSR_COUNT; i++) {
+            ctx->csr[i] = HASH->CSR[i];
+        }
+    }
+    return result;
+}
+
+int mbedtls_sha256_finish(mbedtls_sha256_context *ctx,
+                          unsigned char *output) {
+    if (ctx->software) {
+        return sw_mbedtls_sha256_finish(sw_ctx(ctx), output);
+    }
+    load_context(ctx);
+    // the peripheral pads the message, given the valid bits of its last word
+    HASH->STR = 8 * (ctx->buffered % sizeof(uint32_t));
+    size_t whole = ctx->buffered - ctx->buffered % sizeof(uint32_t);
+    write_words(ctx->buffer, whole);
+    if (whole < ctx->buffered) {
+        uint32_t word = 0;
+        memcpy(&word, ctx->buffer + whole, ctx->buffered - whole);
+        HASH->DIN = word;
+    }
+    HASH->STR |= HASH_STR_DCAL;
+    mbedtls_platform_zeroize(ctx->buffer, sizeof(ctx->buffer));
+    int result = wait_status(HASH_SR_DCIS);
+    // the digest has been computed from the state of this context
+    loaded = NULL;
+    if (result) {
+        return result;
+    }
+
+    uint32_t digest[SHA256_DIGEST_WORDS];
+    for (size_t i = 0; i < SHA256_DIGEST_WORDS; i++) {
+        // the first words are also mapped next to the control registers
+        digest[i] = __REV(i < 5 ? HASH->HR[i] : HASH_DIGEST->HR[i]);
+    }
+    memcpy(output, digest,
+           (ctx->is224 ? SHA224_DIGEST_WORDS : SHA256_DIGEST_WORDS)
+                   * sizeof(uint32_t));
+    mbedtls_platform_zeroize(digest, sizeof(digest));
+    return 0;
+}
+
+// FIPS 180-2 examples
+static const char TEST_SHORT[] = "abc";
+static const unsigned char TEST_SHORT_DIGEST[] = {
+    0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40,
+    0xde, 0x5d, 0xae, 0x22, 0x23, 0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17,
+    0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad
+};
+static const char TEST_LONG[] =
+        "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+static const unsigned char TEST_LONG_DIGEST[] = {
+    0x24, 0x8d, 0x6a, 0x61, 0xd2, 0x06, 0x38, 0xb8, 0xe5, 0xc0, 0x26,
+    0x93, 0x0c, 0x3e, 0x60, 0x39, 0xa3, 0x3c, 0xe4, 0x59, 0x64, 0xff,
+    0x21, 0x67, 0xf6, 0xec, 0xed, 0xd4, 0x19, 0xdb, 0x06, 0xc1
+};
+
+#    define TEST_LONG_LEN (sizeof(TEST_LONG) - 1)
+// enough for several blocks, and pieces that don't line up with them
+#    define TEST_INTERLEAVED_REPEATS 5
+#    define TEST_INTERLEAVED_PIECE 23
+
+static bool test_digest(const char *input, const unsigned char *expected) {
+    mbedtls_sha256_context ctx;
+    unsigned char output[32];
+    mbedtls_sha256_init(&ctx);
+    reset(&ctx, 0);
+    bool ok = !mbedtls_sha256_update(&ctx, (const unsigned char *) input,
+                                     strlen(input))
+              && !mbedtls_sha256_finish(&ctx, output)
+              && !memcmp(output, expected, sizeof(output));
+    mbedtls_sha256_free(&ctx);
+    return ok;
+}
+
+/**
+ * Hashes the same input in one piece, and in two digests fed alternately in
+ * pieces, so that the context is swapped on every piece. All three have to
+ * agree.
+ */
+static bool test_interleaved(void) {
+    mbedtls_sha256_context ctx[2];
+    unsigned char expected[32];
+    unsigned char output[32];
+    const unsigned char *input = (const unsigned char *) TEST_LONG;
+    bool ok = true;
+
+    mbedtls_sha256_init(&ctx[0]);
+    mbedtls_sha256_init(&ctx[1]);
+    reset(&ctx[0], 0);
+    for (size_t i = 0; i < TEST_INTERLEAVED_REPEATS && ok; i++) {
+        ok = !mbedtls_sha256_update(&ctx[0], input, TEST_LONG_LEN);
+    }
+    ok = ok && !mbedtls_sha256_finish(&ctx[0], expected);
+
+    reset(&ctx[0], 0);
+    reset(&ctx[1], 0);
+    for (size_t i = 0; i < TEST_INTERLEAVED_REPEATS && ok; i++) {
+        for (size_t offset = 0; offset < TEST_LONG_LEN && ok;
+             offset += TEST_INTERLEAVED_PIECE) {
+            size_t len = TEST_LONG_LEN - offset;
+            if (len > TEST_INTERLEAVED_PIECE) {
+                len = TEST_INTERLEAVED_PIECE;
+            }
+            ok = !mbedtls_sha256_update(&ctx[0], input + offset, len)
+                 && !mbedtls_sha256_update(&ctx[1], input + offset, len);
+        }
+    }
+    for (size_t i = 0; i < 2 && ok; i++) {
+        ok = !mbedtls_sha256_finish(&ctx[i], output)
+             && !memcmp(output, expected, sizeof(output));
+    }
+    mbedtls_sha256_free(&ctx[0]);
+    mbedtls_sha256_free(&ctx[1]);
+    return ok;
+}
+
+static bool self_test(void) {
+    return test_digest(TEST_SHORT, TEST_SHORT_DIGEST)
+           && test_digest(TEST_LONG, TEST_LONG_DIGEST) && test_interleaved();
+}
+
+#endif // MBEDTLS_SHA256_ALT
@@ -0,0 +1,52 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#ifndef SHA256_ALT_H
+#define SHA256_ALT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// HASH_CSR0 to HASH_CSR37 hold the whole state of a SHA-224/SHA-256 digest in
+// hash mode, including the words waiting in the input FIFO
+#define SHA256_ALT_CSR_COUNT 38
+
+// input is written to the peripheral a block at a time, and the very first
+// block is only processed once a word of the next one has been written
+#define SHA256_ALT_BLOCK_SIZE 64
+#define SHA256_ALT_FIRST_BLOCK_SIZE (SHA256_ALT_BLOCK_SIZE + 4)
+
+// mbedtls_sha256_context of the software implementation, see sha256_sw.c
+#define SHA256_ALT_SW_CONTEXT_WORDS 28
+
+/*
+ * Digest computed by the HASH peripheral, see sha256_alt.c. The peripheral
+ * state is saved here after each update, so that any number of digests can be
+ * computed at a time.
+ */
+typedef struct mbedtls_sha256_context {
+    union {
+        struct {
+            uint32_t csr[SHA256_ALT_CSR_COUNT];
+            unsigned char buffer[SHA256_ALT_FIRST_BLOCK_SIZE];
+            size_t buffered;
+            // true once any input has been written to the peripheral, i.e.
+            // csr holds the state to restore
+            bool started;
+        };
+        // if the peripheral failed its self-test, the digest is computed in
+        // software instead
+        uint32_t sw[SHA256_ALT_SW_CONTEXT_WORDS];
+    };
+    bool software;
+    int is224;
+} mbedtls_sha256_context;
+
+#endif // SHA256_ALT_H
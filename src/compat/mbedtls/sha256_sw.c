@@ -0,0 +1,55 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+/*
+ * The software SHA-256 implementation of mbed TLS, for sha256_alt.c to fall
+ * back to. With MBEDTLS_SHA256_ALT, it is left out of the library, so
+ * sha256.c is built here once more without it, with its functions and its
+ * context type renamed, the same way as aes.c in aes_sw.c.
+ */
+
+#include <stdint.h>
+
+#include <anj/utils.h>
+
+#include <mbedtls/build_info.h>
+
+#ifdef MBEDTLS_SHA256_ALT
+
+// NOTE: included before the renames, for SHA256_ALT_SW_CONTEXT_WORDS
+#    include "sha256_alt.h"
+
+// NOTE: build_info.h is not included again, so this holds for sha256.c
+#    undef MBEDTLS_SHA256_ALT
+
+#    define mbedtls_sha256_context sw_mbedtls_sha256_context
+#    define mbedtls_sha256_init sw_mbedtls_sha256_init
+#    define mbedtls_sha256_free sw_mbedtls_sha256_free
+#    define mbedtls_sha256_clone sw_mbedtls_sha256_clone
+#    define mbedtls_sha256_starts sw_mbedtls_sha256_starts
+#    define mbedtls_internal_sha256_process sw_mbedtls_internal_sha256_process
+#    define mbedtls_sha256_update sw_mbedtls_sha256_update
+#    define mbedtls_sha256_finish sw_mbedtls_sha256_finish
+#    define mbedtls_sha256 sw_mbedtls_sha256
+#    define mbedtls_sha224_self_test sw_mbedtls_sha224_self_test
+#    define mbedtls_sha256_self_test sw_mbedtls_sha256_self_test
+
+#    include "../../../deps/mbedtls/library/sha256.c"
+
+// checks the declarations used by sha256_alt.c against the definitions
+#    include "sha256_sw.h"
+
+ANJ_STATIC_ASSERT(sizeof(sw_mbedtls_sha256_context)
+                                  <= SHA256_ALT_SW_CONTEXT_WORDS
+                                             * sizeof(uint32_t)
+                          && _Alignof(sw_mbedtls_sha256_context)
+                                     <= _Alignof(uint32_t),
+                  sha256_alt_sw_context_too_small);
+
+#endif // MBEDTLS_SHA256_ALT
@@ -0,0 +1,35 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#ifndef SHA256_SW_H
+#define SHA256_SW_H
+
+#include <stddef.h>
+
+/*
+ * Software SHA-256 of mbed TLS, used by sha256_alt.c if the HASH peripheral
+ * fails its self-test, see sha256_sw.c. The context is kept in the sw member
+ * of the mbedtls_sha256_context of sha256_alt.h.
+ */
+
+struct sw_mbedtls_sha256_context;
+
+void sw_mbedtls_sha256_init(struct sw_mbedtls_sha256_context *ctx);
+
+int sw_mbedtls_sha256_starts(struct sw_mbedtls_sha256_context *ctx,
+                             int is224);
+
+int sw_mbedtls_sha256_update(struct sw_mbedtls_sha256_context *ctx,
+                             const unsigned char *input,
+                             size_t ilen);
+
+int sw_mbedtls_sha256_finish(struct sw_mbedtls_sha256_context *ctx,
+                             unsigned char *output);
+
+#endif // SHA256_SW_H
@@ -14,6 +14,7 @@
 #include <anj/compat/time.h>
 
 #include "mbedtls/timing.h"
+#include "timebase.h"
 #include "timing_alt.h"
 
 /* This function is an external definition of function used inside MbedTLS
@@ -23,8 +24,8 @@
 // to avoid the implicit declaration warning
 unsigned long mbedtls_timing_hardclock(void);
 unsigned long mbedtls_timing_hardclock(void) {
-    return anj_time_monotonic_to_scalar(anj_time_monotonic_now(),
-                                        ANJ_TIME_UNIT_US);
+    // only differences are meaningful, so truncation to 32 bits is fine
+    return (unsigned long) timebase_now_us();
 }
 
 unsigned long mbedtls_timing_get_timer(struct mbedtls_timing_hr_time *val,
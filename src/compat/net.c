@@ -17,40 +17,63 @@
 
 #include "modem/modem.h"
 #include "modem/modem_constants.h"
+#include "modem/modem_sleep.h"
+
+#include "dtls_cid.h"
+#include "net_mtu.h"
+#include "net_stats.h"
+
+#define net_log(...) anj_log(net, __VA_ARGS__)
 
 typedef enum {
     CURRENT_OP_NONE,
     CURRENT_OP_CONNECT,
+    CURRENT_OP_QUERY_PORT,
     CURRENT_OP_SEND,
-    CURRENT_OP_SHUTDOWN
+    CURRENT_OP_SHUTDOWN,
+    CURRENT_OP_REOPEN_CLOSE,
+    CURRENT_OP_REOPEN
 } current_op_t;
 
 typedef union {
     modem_socket_open_ctx_t open;
     modem_socket_send_ctx_t send;
+    modem_socket_stream_send_ctx_t stream_send;
+    modem_socket_close_ctx_t close;
+    modem_socket_state_ctx_t state;
 } op_ctx_t;
 
 typedef struct {
     bool used;
+    modem_socket_type_t type;
     anj_net_socket_state_t state;
     current_op_t current_op;
     op_ctx_t op_ctx;
+    // 0 if unknown
+    uint16_t last_local_port;
+    bool reuse_last_port;
+#ifdef CONFIG_DTLS_CID
+    // remote end of the socket, to open a new one; empty if it doesn't fit
+    char hostname[64];
+    char port[6];
+    // the socket has been reopened since the last successful send
+    bool reopened;
+#endif // CONFIG_DTLS_CID
 } net_ctx_t;
 
 // Current implementation limitations:
 // - only one socket supported at a time, support for multiple sockets would
 //   require:
 //   - context storage as array
-//   - any "locking" mechanism on modem communication layer to ensure that
-//     multiple sockets do not interfere with each other
 //   - a different way of handling incoming data, e.g. by using "buffer access"
 //     mode URCs instead of "direct push" mode (per BG96 TCP/IP AT Commands
 //     Manual)
-// - only UDP sockets supported
 // - only IPv4 sockets supported
 static net_ctx_t ctx_storage;
 
-static int net_create_ctx(net_ctx_t **ctx, const anj_net_config_t *config) {
+static int net_create_ctx(net_ctx_t **ctx,
+                          const anj_net_config_t *config,
+                          modem_socket_type_t type) {
     if (ctx_storage.used) {
         return -1;
     }
@@ -60,17 +83,48 @@ static int net_create_ctx(net_ctx_t **ctx, const anj_net_config_t *config) {
         return ANJ_NET_ENOTSUP;
     }
     ctx_storage.used = true;
+    ctx_storage.type = type;
     ctx_storage.state = ANJ_NET_SOCKET_STATE_CLOSED;
     ctx_storage.current_op = CURRENT_OP_NONE;
+    ctx_storage.last_local_port = 0;
+    ctx_storage.reuse_last_port = false;
     *ctx = &ctx_storage;
     return 0;
 }
 
+// Wakes the modem up after net_queue_mode_rx_off(), if needed
+static int wake_modem(int in_progress_code) {
+    int res = modem_sleep_wake();
+    if (res > 0) {
+        return in_progress_code;
+    }
+    return res;
+}
+
 static int
 net_connect(net_ctx_t *ctx, const char *hostname, const char *port_str) {
     switch (ctx->current_op) {
     case CURRENT_OP_NONE: {
-        int res = modem_socket_open_init(&ctx->op_ctx.open, hostname, port_str);
+        int wake_res = wake_modem(ANJ_NET_EINPROGRESS);
+        if (wake_res) {
+            return wake_res;
+        }
+        uint16_t local_port = ctx->reuse_last_port ? ctx->last_local_port : 0;
+        ctx->reuse_last_port = false;
+#ifdef CONFIG_DTLS_CID
+        size_t hostname_len = strlen(hostname);
+        size_t port_len = strlen(port_str);
+        if (hostname_len < sizeof(ctx->hostname)
+                && port_len < sizeof(ctx->port)) {
+            memcpy(ctx->hostname, hostname, hostname_len + 1);
+            memcpy(ctx->port, port_str, port_len + 1);
+        } else {
+            ctx->hostname[0] = '\0';
+        }
+        ctx->reopened = false;
+#endif // CONFIG_DTLS_CID
+        int res = modem_socket_open_init(&ctx->op_ctx.open, ctx->type,
+                                         hostname, port_str, local_port);
         if (res) {
             return -1;
         }
@@ -82,10 +136,32 @@ net_connect(net_ctx_t *ctx, const char *hostname, const char *port_str) {
         if (res > 0) {
             return ANJ_NET_EINPROGRESS;
         }
-        ctx->current_op = CURRENT_OP_NONE;
         if (res < 0) {
+            ctx->current_op = CURRENT_OP_NONE;
             return -1;
         }
+        // remember the local port, so that it can be reused on reconnection
+        // and the server still sees the same DTLS session endpoint
+        if (modem_socket_local_port_init(&ctx->op_ctx.state)) {
+            ctx->current_op = CURRENT_OP_NONE;
+            ctx->state = ANJ_NET_SOCKET_STATE_CONNECTED;
+            return 0;
+        }
+        ctx->current_op = CURRENT_OP_QUERY_PORT;
+        return ANJ_NET_EINPROGRESS;
+    }
+    case CURRENT_OP_QUERY_PORT: {
+        int res = modem_socket_local_port_continue(&ctx->op_ctx.state,
+                                                   &ctx->last_local_port);
+        if (res > 0) {
+            return ANJ_NET_EINPROGRESS;
+        }
+        if (res < 0) {
+            // not critical, the socket is open anyway
+            net_log(L_WARNING, "could not determine local port");
+            ctx->last_local_port = 0;
+        }
+        ctx->current_op = CURRENT_OP_NONE;
         ctx->state = ANJ_NET_SOCKET_STATE_CONNECTED;
         return 0;
     }
@@ -93,25 +169,95 @@ net_connect(net_ctx_t *ctx, const char *hostname, const char *port_str) {
     }
 }
 
-static int net_send(net_ctx_t *ctx,
-                    size_t *bytes_sent,
-                    const uint8_t *buf,
-                    size_t length) {
-    if (ctx->state != ANJ_NET_SOCKET_STATE_CONNECTED) {
+static int net_get_inner_mtu(net_ctx_t *ctx, int32_t *out_value) {
+    // The usable payload is limited both by the link MTU and by the maximum
+    // message size that the modem can handle in a single AT+QISEND command:
+    //
+    // "<send_length> Integer type. The length of data to be sent, which cannot
+    // exceed 1460 bytes."
+    //
+    // NOTE: only IPv4 sockets are supported, see net_create_ctx()
+    int32_t link_payload = CONFIG_NET_LINK_MTU - NET_IPV4_HEADER_LEN;
+    link_payload -= ctx->type == MODEM_SOCKET_TCP ? NET_TCP_HEADER_LEN
+                                                  : NET_UDP_HEADER_LEN;
+    *out_value = ANJ_MIN(link_payload, MODEM_SOCKET_SEND_MAX);
+    return 0;
+}
+
+#ifdef CONFIG_DTLS_CID
+// A UDP socket lost by the modem, e.g. while it slept or after the network
+// dropped the connection, is replaced with a new one, unknown to Anjay Lite.
+// The DTLS session goes on over it: the server finds the session by the CID
+// carried in the next record, even though it comes from a new address and
+// port. Without a CID, the error is reported and Anjay Lite reconnects with
+// a new handshake.
+static bool can_reopen(net_ctx_t *ctx) {
+    return ctx->type == MODEM_SOCKET_UDP && ctx->hostname[0]
+           && dtls_cid_in_use();
+}
+
+static int reopen_start(net_ctx_t *ctx) {
+    net_log(L_INFO, "socket lost, reopening it for the DTLS session");
+    // the connection ID stays taken until the closed socket is released
+    if (modem_socket_close_init(&ctx->op_ctx.close)) {
         return -1;
     }
-    // NOTE: change this when adding support for TCP
-    // NOTE: technically, there's no limit for maximum length of TCP message
-    // that Anjay Lite can send, but the modem still has the limit; in such case
-    // the message should be sent in multiple parts
-    bool is_udp = true;
-    if (is_udp && length > MODEM_SOCKET_SEND_MAX) {
-        // modem cannot send messages longer than 1460 bytes in one go
+    ctx->current_op = CURRENT_OP_REOPEN_CLOSE;
+    return ANJ_NET_EINPROGRESS;
+}
+
+static int reopen_continue(net_ctx_t *ctx) {
+    if (ctx->current_op == CURRENT_OP_REOPEN_CLOSE) {
+        // NOTE: the result is ignored, the socket might be released already
+        if (modem_socket_close_continue(&ctx->op_ctx.close) > 0) {
+            return ANJ_NET_EINPROGRESS;
+        }
+        // the address changes anyway, so let the modem choose the port
+        if (modem_socket_open_init(&ctx->op_ctx.open, ctx->type, ctx->hostname,
+                                   ctx->port, 0)) {
+            ctx->current_op = CURRENT_OP_NONE;
+            return -1;
+        }
+        ctx->current_op = CURRENT_OP_REOPEN;
+        return ANJ_NET_EINPROGRESS;
+    }
+    int res = modem_socket_open_continue(&ctx->op_ctx.open);
+    if (res > 0) {
+        return ANJ_NET_EINPROGRESS;
+    }
+    ctx->current_op = CURRENT_OP_NONE;
+    if (res < 0) {
+        net_log(L_ERROR, "could not reopen the socket");
+        return -1;
+    }
+    // the port is not known, and there's no use in reusing it
+    ctx->last_local_port = 0;
+    ctx->reopened = true;
+    // the datagram is sent on the next call
+    return ANJ_NET_EINPROGRESS;
+}
+#endif // CONFIG_DTLS_CID
+
+static int net_send_datagram(net_ctx_t *ctx,
+                             size_t *bytes_sent,
+                             const uint8_t *buf,
+                             size_t length) {
+    int32_t mtu;
+    net_get_inner_mtu(ctx, &mtu);
+    if (length > (size_t) mtu) {
+        // sending it would either fail or cause IP fragmentation
         return ANJ_NET_EMSGSIZE;
     }
     switch (ctx->current_op) {
     case CURRENT_OP_NONE: {
-        int res = modem_socket_send_init(&ctx->op_ctx.send, length);
+#ifdef CONFIG_DTLS_CID
+        // NOTE: only once until a send succeeds, like below; a socket that
+        // closes again right away is not reopened over and over
+        if (modem_socket_closed() && !ctx->reopened && can_reopen(ctx)) {
+            return reopen_start(ctx);
+        }
+#endif // CONFIG_DTLS_CID
+        int res = modem_socket_send_init(&ctx->op_ctx.send, buf, length);
         if (res) {
             return -1;
         }
@@ -119,31 +265,97 @@ static int net_send(net_ctx_t *ctx,
         return ANJ_NET_EINPROGRESS;
     }
     case CURRENT_OP_SEND: {
-        int res = modem_socket_send_continue(&ctx->op_ctx.send, length, buf);
+        int res = modem_socket_send_continue(&ctx->op_ctx.send);
         if (res > 0) {
             return ANJ_NET_EINPROGRESS;
         }
         ctx->current_op = CURRENT_OP_NONE;
         if (res < 0) {
+#ifdef CONFIG_DTLS_CID
+            // the socket may be gone without a URC, e.g. if the modem was
+            // asleep; a new one is tried once
+            if (!ctx->reopened && can_reopen(ctx)) {
+                return reopen_start(ctx);
+            }
+#endif // CONFIG_DTLS_CID
             return -1;
         }
+#ifdef CONFIG_DTLS_CID
+        ctx->reopened = false;
+#endif // CONFIG_DTLS_CID
         *bytes_sent = length;
         return 0;
     }
+#ifdef CONFIG_DTLS_CID
+    case CURRENT_OP_REOPEN_CLOSE:
+    case CURRENT_OP_REOPEN: {
+        return reopen_continue(ctx);
+    }
+#endif // CONFIG_DTLS_CID
+    default: { return -1; }
+    }
+}
+
+// NOTE: there's no limit for the length of TCP messages that Anjay Lite can
+// send, but the modem still has the limit, so longer messages are split into
+// chunks; a partial send is reported if the message does not fit in
+// MODEM_TCP_SEND_PIPELINE chunks
+static int net_send_stream(net_ctx_t *ctx,
+                           size_t *bytes_sent,
+                           const uint8_t *buf,
+                           size_t length) {
+    switch (ctx->current_op) {
+    case CURRENT_OP_NONE: {
+        int res = modem_socket_stream_send_init(&ctx->op_ctx.stream_send, buf,
+                                                length);
+        if (res) {
+            return -1;
+        }
+        ctx->current_op = CURRENT_OP_SEND;
+        return ANJ_NET_EINPROGRESS;
+    }
+    case CURRENT_OP_SEND: {
+        int res = modem_socket_stream_send_continue(&ctx->op_ctx.stream_send,
+                                                    bytes_sent);
+        if (res > 0) {
+            return ANJ_NET_EINPROGRESS;
+        }
+        ctx->current_op = CURRENT_OP_NONE;
+        return res < 0 ? -1 : 0;
+    }
     default: { return -1; }
     }
 }
 
+static int net_send(net_ctx_t *ctx,
+                    size_t *bytes_sent,
+                    const uint8_t *buf,
+                    size_t length) {
+    if (ctx->state != ANJ_NET_SOCKET_STATE_CONNECTED) {
+        return -1;
+    }
+    int wake_res = wake_modem(ANJ_NET_EINPROGRESS);
+    if (wake_res) {
+        return wake_res;
+    }
+    if (ctx->type == MODEM_SOCKET_TCP) {
+        return net_send_stream(ctx, bytes_sent, buf, length);
+    }
+    return net_send_datagram(ctx, bytes_sent, buf, length);
+}
+
 static int
 net_recv(net_ctx_t *ctx, size_t *bytes_received, uint8_t *buf, size_t length) {
     if (ctx->state != ANJ_NET_SOCKET_STATE_CONNECTED
             && ctx->state != ANJ_NET_SOCKET_STATE_SHUTDOWN) {
         return -1;
     }
-    if (ctx->current_op != CURRENT_OP_NONE) {
-        // NOTE: check whether that should be EAGAIN or some fatal -1
-        return ANJ_NET_EAGAIN;
+    int wake_res = wake_modem(ANJ_NET_EAGAIN);
+    if (wake_res) {
+        return wake_res;
     }
+    // NOTE: incoming data is dispatched by the modem command queue, so it can
+    // be received even if some other operation is in progress
     int res = modem_socket_try_recv(buf, length, bytes_received);
     if (res > 0) {
         return ANJ_NET_EAGAIN;
@@ -151,9 +363,7 @@ net_recv(net_ctx_t *ctx, size_t *bytes_received, uint8_t *buf, size_t length) {
     if (res < 0) {
         return -1;
     }
-    // NOTE: change this when adding support for TCP
-    bool is_udp = true;
-    if (*bytes_received == length && is_udp) {
+    if (*bytes_received == length && ctx->type == MODEM_SOCKET_UDP) {
         // if the whole buffer is filled, we don't know if if the buffer was
         // filled completely, the message might be truncated
         return ANJ_NET_EMSGSIZE;
@@ -161,12 +371,21 @@ net_recv(net_ctx_t *ctx, size_t *bytes_received, uint8_t *buf, size_t length) {
     return 0;
 }
 
+static void cancel_current_op(net_ctx_t *ctx) {
+    if (ctx->current_op == CURRENT_OP_SEND && ctx->type == MODEM_SOCKET_TCP) {
+        modem_socket_stream_send_cancel(&ctx->op_ctx.stream_send);
+    } else if (ctx->current_op != CURRENT_OP_NONE) {
+        modem_op_cancel((modem_op_t *) &ctx->op_ctx);
+    }
+    ctx->current_op = CURRENT_OP_NONE;
+}
+
 // Note: since there's no differentiation between shutdown and close operations
 // on BG96, do the defacto close operation here.
 static int net_shutdown(net_ctx_t *ctx) {
     switch (ctx->current_op) {
     case CURRENT_OP_SHUTDOWN: {
-        int res = modem_socket_close_continue();
+        int res = modem_socket_close_continue(&ctx->op_ctx.close);
         if (res > 0) {
             return ANJ_NET_EINPROGRESS;
         }
@@ -178,7 +397,13 @@ static int net_shutdown(net_ctx_t *ctx) {
         return 0;
     }
     default: {
-        int res = modem_socket_close_init();
+        int wake_res = wake_modem(ANJ_NET_EINPROGRESS);
+        if (wake_res) {
+            return wake_res;
+        }
+        // abandon e.g. an unfinished send, closing takes precedence
+        cancel_current_op(ctx);
+        int res = modem_socket_close_init(&ctx->op_ctx.close);
         if (res) {
             return -1;
         }
@@ -201,30 +426,27 @@ static int net_close(net_ctx_t *ctx) {
     return net_shutdown(ctx);
 }
 
-static int net_get_inner_mtu(net_ctx_t *ctx, int32_t *out_value) {
-    // This is not necessarily the MTU of the underlying network, but its the
-    // maximum message size that the modem can handle in a single AT+QISEND
-    // command.
-    //
-    // "<send_length> Integer type. The length of data to be sent, which cannot
-    // exceed 1460 bytes."
-    (void) ctx;
-    *out_value = 1460;
-    return 0;
-}
-
 static int net_get_state(net_ctx_t *ctx, anj_net_socket_state_t *out_value) {
     *out_value = ctx->state;
     return 0;
 }
 
 static int net_reuse_last_port(net_ctx_t *ctx) {
-    (void) ctx;
-    return ANJ_NET_ENOTSUP; // not implemented
+    if (ctx->state != ANJ_NET_SOCKET_STATE_CLOSED || !ctx->last_local_port) {
+        return -1;
+    }
+    // applied on the next connect
+    ctx->reuse_last_port = true;
+    return 0;
 }
 
 static int net_cleanup_ctx(net_ctx_t **ctx) {
     int close_result = 0;
+    if ((*ctx)->state == ANJ_NET_SOCKET_STATE_CLOSED
+            && (*ctx)->current_op != CURRENT_OP_NONE) {
+        // e.g. connection attempt abandoned by the caller
+        cancel_current_op(*ctx);
+    }
     if ((*ctx)->state != ANJ_NET_SOCKET_STATE_CLOSED) {
         close_result = net_close(*ctx);
         if (close_result == ANJ_NET_EINPROGRESS) {
@@ -236,14 +458,20 @@ static int net_cleanup_ctx(net_ctx_t **ctx) {
     return close_result;
 }
 
+// NOTE: anything received while RX is off is lost; in queue mode, the server
+// holds back requests until the next Update from the client, which wakes the
+// modem up again
 static int net_queue_mode_rx_off(anj_net_ctx_t *ctx) {
     (void) ctx;
+    if (modem_sleep_enter()) {
+        return -1;
+    }
     return ANJ_NET_OK;
 }
 
 #ifdef ANJ_NET_WITH_UDP
 int anj_udp_create_ctx(anj_net_ctx_t **ctx, const anj_net_config_t *config) {
-    return net_create_ctx((net_ctx_t **) ctx, config);
+    return net_create_ctx((net_ctx_t **) ctx, config, MODEM_SOCKET_UDP);
 }
 
 int anj_udp_cleanup_ctx(anj_net_ctx_t **ctx) {
@@ -260,14 +488,19 @@ int anj_udp_send(anj_net_ctx_t *ctx,
                  size_t *bytes_sent,
                  const uint8_t *buf,
                  size_t length) {
-    return net_send((net_ctx_t *) ctx, bytes_sent, buf, length);
+    return net_stats_sent(NET_STATS_UDP,
+                          net_send((net_ctx_t *) ctx, bytes_sent, buf, length),
+                          bytes_sent);
 }
 
 int anj_udp_recv(anj_net_ctx_t *ctx,
                  size_t *bytes_received,
                  uint8_t *buf,
                  size_t length) {
-    return net_recv((net_ctx_t *) ctx, bytes_received, buf, length);
+    return net_stats_received(
+            NET_STATS_UDP,
+            net_recv((net_ctx_t *) ctx, bytes_received, buf, length),
+            bytes_received);
 }
 
 int anj_udp_shutdown(anj_net_ctx_t *ctx) {
@@ -294,3 +527,62 @@ int anj_udp_queue_mode_rx_off(anj_net_ctx_t *ctx) {
     return net_queue_mode_rx_off(ctx);
 }
 #endif // ANJ_NET_WITH_UDP
+
+#ifdef ANJ_NET_WITH_TCP
+int anj_tcp_create_ctx(anj_net_ctx_t **ctx, const anj_net_config_t *config) {
+    return net_create_ctx((net_ctx_t **) ctx, config, MODEM_SOCKET_TCP);
+}
+
+int anj_tcp_cleanup_ctx(anj_net_ctx_t **ctx) {
+    return net_cleanup_ctx((net_ctx_t **) ctx);
+}
+
+int anj_tcp_connect(anj_net_ctx_t *ctx,
+                    const char *hostname,
+                    const char *port) {
+    return net_connect((net_ctx_t *) ctx, hostname, port);
+}
+
+int anj_tcp_send(anj_net_ctx_t *ctx,
+                 size_t *bytes_sent,
+                 const uint8_t *buf,
+                 size_t length) {
+    return net_stats_sent(NET_STATS_TCP,
+                          net_send((net_ctx_t *) ctx, bytes_sent, buf, length),
+                          bytes_sent);
+}
+
+int anj_tcp_recv(anj_net_ctx_t *ctx,
+                 size_t *bytes_received,
+                 uint8_t *buf,
+                 size_t length) {
+    return net_stats_received(
+            NET_STATS_TCP,
+            net_recv((net_ctx_t *) ctx, bytes_received, buf, length),
+            bytes_received);
+}
+
+int anj_tcp_shutdown(anj_net_ctx_t *ctx) {
+    return net_shutdown((net_ctx_t *) ctx);
+}
+
+int anj_tcp_close(anj_net_ctx_t *ctx) {
+    return net_close((net_ctx_t *) ctx);
+}
+
+int anj_tcp_get_state(anj_net_ctx_t *ctx, anj_net_socket_state_t *out_value) {
+    return net_get_state((net_ctx_t *) ctx, out_value);
+}
+
+int anj_tcp_get_inner_mtu(anj_net_ctx_t *ctx, int32_t *out_value) {
+    return net_get_inner_mtu((net_ctx_t *) ctx, out_value);
+}
+
+int anj_tcp_reuse_last_port(anj_net_ctx_t *ctx) {
+    return net_reuse_last_port((net_ctx_t *) ctx);
+}
+
+int anj_tcp_queue_mode_rx_off(anj_net_ctx_t *ctx) {
+    return net_queue_mode_rx_off(ctx);
+}
+#endif // ANJ_NET_WITH_TCP
@@ -0,0 +1,60 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#ifndef NET_MTU_H
+#define NET_MTU_H
+
+#include <anj/anj_config.h>
+
+#include <mbedtls/build_info.h>
+
+// MTU of the cellular link, i.e. the largest IP packet that is not fragmented.
+// 1500 is common for LTE, but some carriers use less, e.g. 1280 or 1358.
+#ifndef CONFIG_NET_LINK_MTU
+#    define CONFIG_NET_LINK_MTU 1500
+#endif // CONFIG_NET_LINK_MTU
+
+#define NET_IPV4_HEADER_LEN 20
+#define NET_IPV6_HEADER_LEN 40
+#define NET_UDP_HEADER_LEN 8
+#define NET_TCP_HEADER_LEN 20
+
+// DTLS 1.2 record header, followed by the explicit nonce and the tag of CCM-8
+// ciphersuites, which are the only ones enabled
+#define NET_DTLS_RECORD_HEADER_LEN 13
+#define NET_DTLS_CCM_8_EXPANSION (8 + 8)
+#ifdef MBEDTLS_SSL_DTLS_CONNECTION_ID
+// the CID is chosen by the server, so assume the longest one accepted; records
+// with a CID wrap the plaintext in a DTLSInnerPlaintext, which adds the real
+// content type and zero padding up to a multiple of the padding granularity
+#    define NET_DTLS_CID_EXPANSION                      \
+        (MBEDTLS_SSL_CID_OUT_LEN_MAX + 1                \
+         + MBEDTLS_SSL_CID_PADDING_GRANULARITY - 1)
+#else // MBEDTLS_SSL_DTLS_CONNECTION_ID
+#    define NET_DTLS_CID_EXPANSION 0
+#endif // MBEDTLS_SSL_DTLS_CONNECTION_ID
+#define NET_DTLS_MAX_EXPANSION                                  \
+    (NET_DTLS_RECORD_HEADER_LEN + NET_DTLS_CCM_8_EXPANSION \
+     + NET_DTLS_CID_EXPANSION)
+
+// Largest UDP payload that fits in a single IPv4 packet on the link
+#define NET_UDP_IPV4_LINK_PAYLOAD \
+    (CONFIG_NET_LINK_MTU - NET_IPV4_HEADER_LEN - NET_UDP_HEADER_LEN)
+
+// NOTE: Anjay Lite does not fragment CoAP messages, so the largest one has to
+// fit in a single DTLS record, and the record in a single IP packet
+#if ANJ_OUT_MSG_BUFFER_SIZE > MBEDTLS_SSL_OUT_CONTENT_LEN
+#    error "MBEDTLS_SSL_OUT_CONTENT_LEN is too small for ANJ_OUT_MSG_BUFFER_SIZE"
+#endif
+#if ANJ_OUT_MSG_BUFFER_SIZE + NET_DTLS_MAX_EXPANSION \
+        > NET_UDP_IPV4_LINK_PAYLOAD
+#    error "ANJ_OUT_MSG_BUFFER_SIZE does not fit in a DTLS record on the link"
+#endif
+
+#endif // NET_MTU_H
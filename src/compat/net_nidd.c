@@ -0,0 +1,316 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <anj/compat/net/anj_net_api.h>
+#include <anj/log.h>
+#include <anj/utils.h>
+
+#include "modem/modem.h"
+#include "modem/modem_constants.h"
+#include "modem/modem_sleep.h"
+
+#include "net_stats.h"
+
+// NOTE: with Non-IP Data Delivery, there are no sockets or IP addresses on the
+// device side. Datagrams sent with AT+CSODCP are routed by the network (SCEF)
+// to the LwM2M server configured for the APN, so the hostname and port given
+// by Anjay Lite are only used to tell the connections apart and are otherwise
+// ignored. "Connecting" just requires the Non-IP PDN connection, which is
+// activated during modem bringup.
+
+typedef struct {
+    bool used;
+    anj_net_socket_state_t state;
+    bool send_in_progress;
+    modem_nidd_send_ctx_t send_ctx;
+} net_ctx_t;
+
+// There's only one Non-IP PDN connection, so only one socket makes sense
+static net_ctx_t ctx_storage;
+
+// Wakes the modem up after net_queue_mode_rx_off(), if needed
+static int wake_modem(int in_progress_code) {
+    int res = modem_sleep_wake();
+    if (res > 0) {
+        return in_progress_code;
+    }
+    return res;
+}
+
+static int net_create_ctx(net_ctx_t **ctx, const anj_net_config_t *config) {
+    (void) config;
+    if (ctx_storage.used) {
+        return -1;
+    }
+    ctx_storage.used = true;
+    ctx_storage.state = ANJ_NET_SOCKET_STATE_CLOSED;
+    ctx_storage.send_in_progress = false;
+    *ctx = &ctx_storage;
+    return 0;
+}
+
+static int
+net_connect(net_ctx_t *ctx, const char *hostname, const char *port_str) {
+    (void) hostname;
+    (void) port_str;
+    int wake_res = wake_modem(ANJ_NET_EINPROGRESS);
+    if (wake_res) {
+        return wake_res;
+    }
+    ctx->state = ANJ_NET_SOCKET_STATE_CONNECTED;
+    return 0;
+}
+
+static int net_get_inner_mtu(net_ctx_t *ctx, int32_t *out_value) {
+    (void) ctx;
+    // there are no IP or UDP headers, the limit is set by the network and the
+    // size of the hex-encoded AT+CSODCP command
+    *out_value = MODEM_NIDD_DATA_MAX;
+    return 0;
+}
+
+static int net_send(net_ctx_t *ctx,
+                    size_t *bytes_sent,
+                    const uint8_t *buf,
+                    size_t length) {
+    if (ctx->state != ANJ_NET_SOCKET_STATE_CONNECTED) {
+        return -1;
+    }
+    if (length > MODEM_NIDD_DATA_MAX) {
+        return ANJ_NET_EMSGSIZE;
+    }
+    int wake_res = wake_modem(ANJ_NET_EINPROGRESS);
+    if (wake_res) {
+        return wake_res;
+    }
+    if (!ctx->send_in_progress) {
+        if (modem_nidd_send_init(&ctx->send_ctx, buf, length)) {
+            return -1;
+        }
+        ctx->send_in_progress = true;
+        return ANJ_NET_EINPROGRESS;
+    }
+    int res = modem_nidd_send_continue(&ctx->send_ctx);
+    if (res > 0) {
+        return ANJ_NET_EINPROGRESS;
+    }
+    ctx->send_in_progress = false;
+    if (res < 0) {
+        return -1;
+    }
+    *bytes_sent = length;
+    return 0;
+}
+
+static int
+net_recv(net_ctx_t *ctx, size_t *bytes_received, uint8_t *buf, size_t length) {
+    if (ctx->state != ANJ_NET_SOCKET_STATE_CONNECTED) {
+        return -1;
+    }
+    int wake_res = wake_modem(ANJ_NET_EAGAIN);
+    if (wake_res) {
+        return wake_res;
+    }
+    // NOTE: +CRTDCP data is stored in the same receive queue as socket data
+    int res = modem_socket_try_recv(buf, length, bytes_received);
+    if (res > 0) {
+        return ANJ_NET_EAGAIN;
+    }
+    if (res < 0) {
+        return -1;
+    }
+    if (*bytes_received == length) {
+        // the message might be truncated, see net.c
+        return ANJ_NET_EMSGSIZE;
+    }
+    return 0;
+}
+
+static void cancel_send(net_ctx_t *ctx) {
+    if (ctx->send_in_progress) {
+        modem_op_cancel(&ctx->send_ctx);
+        ctx->send_in_progress = false;
+    }
+}
+
+// NOTE: the PDN connection is kept active, so there's nothing to close on the
+// modem side
+static int net_shutdown(net_ctx_t *ctx) {
+    cancel_send(ctx);
+    ctx->state = ANJ_NET_SOCKET_STATE_SHUTDOWN;
+    return 0;
+}
+
+static int net_close(net_ctx_t *ctx) {
+    cancel_send(ctx);
+    ctx->state = ANJ_NET_SOCKET_STATE_CLOSED;
+    return 0;
+}
+
+static int net_get_state(net_ctx_t *ctx, anj_net_socket_state_t *out_value) {
+    *out_value = ctx->state;
+    return 0;
+}
+
+static int net_cleanup_ctx(net_ctx_t **ctx) {
+    net_close(*ctx);
+    (*ctx)->used = false;
+    *ctx = NULL;
+    return 0;
+}
+
+// NOTE: downlink data that arrives while RX is off is lost, as with AT sockets
+static int net_queue_mode_rx_off(anj_net_ctx_t *ctx) {
+    (void) ctx;
+    if (modem_sleep_enter()) {
+        return -1;
+    }
+    return ANJ_NET_OK;
+}
+
+#ifdef ANJ_NET_WITH_UDP
+int anj_udp_create_ctx(anj_net_ctx_t **ctx, const anj_net_config_t *config) {
+    return net_create_ctx((net_ctx_t **) ctx, config);
+}
+
+int anj_udp_cleanup_ctx(anj_net_ctx_t **ctx) {
+    return net_cleanup_ctx((net_ctx_t **) ctx);
+}
+
+int anj_udp_connect(anj_net_ctx_t *ctx,
+                    const char *hostname,
+                    const char *port) {
+    return net_connect((net_ctx_t *) ctx, hostname, port);
+}
+
+int anj_udp_send(anj_net_ctx_t *ctx,
+                 size_t *bytes_sent,
+                 const uint8_t *buf,
+                 size_t length) {
+    return net_stats_sent(NET_STATS_UDP,
+                          net_send((net_ctx_t *) ctx, bytes_sent, buf, length),
+                          bytes_sent);
+}
+
+int anj_udp_recv(anj_net_ctx_t *ctx,
+                 size_t *bytes_received,
+                 uint8_t *buf,
+                 size_t length) {
+    return net_stats_received(
+            NET_STATS_UDP,
+            net_recv((net_ctx_t *) ctx, bytes_received, buf, length),
+            bytes_received);
+}
+
+int anj_udp_shutdown(anj_net_ctx_t *ctx) {
+    return net_shutdown((net_ctx_t *) ctx);
+}
+
+int anj_udp_close(anj_net_ctx_t *ctx) {
+    return net_close((net_ctx_t *) ctx);
+}
+
+int anj_udp_get_state(anj_net_ctx_t *ctx, anj_net_socket_state_t *out_value) {
+    return net_get_state((net_ctx_t *) ctx, out_value);
+}
+
+int anj_udp_get_inner_mtu(anj_net_ctx_t *ctx, int32_t *out_value) {
+    return net_get_inner_mtu((net_ctx_t *) ctx, out_value);
+}
+
+int anj_udp_reuse_last_port(anj_net_ctx_t *ctx) {
+    // there are no ports, and the server always sees the same endpoint anyway
+    (void) ctx;
+    return 0;
+}
+
+int anj_udp_queue_mode_rx_off(anj_net_ctx_t *ctx) {
+    return net_queue_mode_rx_off(ctx);
+}
+#endif // ANJ_NET_WITH_UDP
+
+#ifdef ANJ_NET_WITH_TCP
+// NOTE: NIDD is datagram-only, so CoAP over TCP is not available in this mode
+int anj_tcp_create_ctx(anj_net_ctx_t **ctx, const anj_net_config_t *config) {
+    (void) ctx;
+    (void) config;
+    return ANJ_NET_ENOTSUP;
+}
+
+int anj_tcp_cleanup_ctx(anj_net_ctx_t **ctx) {
+    (void) ctx;
+    return 0;
+}
+
+int anj_tcp_connect(anj_net_ctx_t *ctx,
+                    const char *hostname,
+                    const char *port) {
+    (void) ctx;
+    (void) hostname;
+    (void) port;
+    return ANJ_NET_ENOTSUP;
+}
+
+int anj_tcp_send(anj_net_ctx_t *ctx,
+                 size_t *bytes_sent,
+                 const uint8_t *buf,
+                 size_t length) {
+    (void) ctx;
+    (void) bytes_sent;
+    (void) buf;
+    (void) length;
+    return ANJ_NET_ENOTSUP;
+}
+
+int anj_tcp_recv(anj_net_ctx_t *ctx,
+                 size_t *bytes_received,
+                 uint8_t *buf,
+                 size_t length) {
+    (void) ctx;
+    (void) bytes_received;
+    (void) buf;
+    (void) length;
+    return ANJ_NET_ENOTSUP;
+}
+
+int anj_tcp_shutdown(anj_net_ctx_t *ctx) {
+    (void) ctx;
+    return ANJ_NET_ENOTSUP;
+}
+
+int anj_tcp_close(anj_net_ctx_t *ctx) {
+    (void) ctx;
+    return ANJ_NET_ENOTSUP;
+}
+
+int anj_tcp_get_state(anj_net_ctx_t *ctx, anj_net_socket_state_t *out_value) {
+    (void) ctx;
+    *out_value = ANJ_NET_SOCKET_STATE_CLOSED;
+    return 0;
+}
+
+int anj_tcp_get_inner_mtu(anj_net_ctx_t *ctx, int32_t *out_value) {
+    (void) ctx;
+    (void) out_value;
+    return ANJ_NET_ENOTSUP;
+}
+
+int anj_tcp_reuse_last_port(anj_net_ctx_t *ctx) {
+    (void) ctx;
+    return ANJ_NET_ENOTSUP;
+}
+
+int anj_tcp_queue_mode_rx_off(anj_net_ctx_t *ctx) {
+    (void) ctx;
+    return ANJ_NET_ENOTSUP;
+}
+#endif // ANJ_NET_WITH_TCP
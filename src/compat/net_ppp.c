@@ -0,0 +1,645 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <anj/compat/net/anj_net_api.h>
+#include <anj/log.h>
+#include <anj/utils.h>
+
+#include <lwip/dns.h>
+#include <lwip/init.h>
+#include <lwip/ip_addr.h>
+#include <lwip/pbuf.h>
+#include <lwip/tcp.h>
+#include <lwip/timeouts.h>
+#include <lwip/udp.h>
+#include <netif/ppp/pppos.h>
+
+#include "modem/modem.h"
+
+#include "net_mtu.h"
+#include "net_stats.h"
+
+#define net_log(...) anj_log(net, __VA_ARGS__)
+
+#define NET_SOCKETS_MAX 2
+// bytes read from the modem per pppos_input() call
+#define PPP_RX_CHUNK 64
+// datagrams buffered per UDP socket until they're received by Anjay Lite
+#define UDP_RX_QUEUE_LEN 4
+#define PPP_RECONNECT_HOLDOFF_S 5
+
+typedef enum {
+    CONNECT_STATE_IDLE,
+    CONNECT_STATE_WAIT_LINK,
+    CONNECT_STATE_RESOLVING,
+    CONNECT_STATE_RESOLVED,
+    CONNECT_STATE_TCP_HANDSHAKE,
+    // handshake completed, reported by the next call to net_connect()
+    CONNECT_STATE_TCP_CONNECTED,
+    CONNECT_STATE_FAILED
+} connect_state_t;
+
+typedef struct {
+    bool used;
+    bool is_tcp;
+    anj_net_socket_state_t state;
+    anj_net_address_family_setting_t af_setting;
+    connect_state_t connect_state;
+    ip_addr_t remote_addr;
+    u16_t remote_port;
+    u16_t last_local_port;
+    bool reuse_port;
+    union {
+        struct udp_pcb *udp;
+        struct tcp_pcb *tcp;
+    } pcb;
+    // UDP: ring of received datagrams
+    struct pbuf *udp_rx[UDP_RX_QUEUE_LEN];
+    size_t udp_rx_head;
+    size_t udp_rx_count;
+    // TCP: chain of received, not yet consumed segments
+    struct pbuf *tcp_rx;
+    bool tcp_peer_closed;
+    bool tcp_error;
+} net_ctx_t;
+
+// Current implementation limitations:
+// - only a single PPP session is supported; if the modem drops the data call
+//   (NO CARRIER), the link is not redialed, only PPP negotiation is retried
+// - hostname resolution uses DNS servers advertised by the network over IPCP
+static net_ctx_t ctx_storage[NET_SOCKETS_MAX];
+
+static ppp_pcb *ppp;
+static struct netif ppp_netif;
+static bool ppp_link_up;
+
+static u32_t ppp_output_cb(ppp_pcb *pcb,
+                           const void *data,
+                           u32_t len,
+                           void *ctx) {
+    (void) pcb;
+    (void) ctx;
+    if (modem_data_mode_write((const uint8_t *) data, len)) {
+        // TX buffer full, lwIP treats the frame as lost
+        return 0;
+    }
+    return len;
+}
+
+static void ppp_status_cb(ppp_pcb *pcb, int err_code, void *ctx) {
+    (void) ctx;
+    if (err_code == PPPERR_NONE) {
+        net_log(L_INFO, "PPP link up, local address: %s",
+                ipaddr_ntoa(&ppp_netif.ip_addr));
+        ppp_link_up = true;
+        return;
+    }
+    ppp_link_up = false;
+    if (err_code == PPPERR_USER) {
+        return;
+    }
+    net_log(L_WARNING, "PPP link down, error: %d", err_code);
+    ppp_connect(pcb, PPP_RECONNECT_HOLDOFF_S);
+}
+
+// Feeds data received from the modem to the stack and runs its timers. All
+// lwIP callbacks are invoked from here.
+static void ppp_poll(void) {
+    uint8_t buf[PPP_RX_CHUNK];
+    size_t len;
+    while ((len = modem_data_mode_read(buf, sizeof(buf))) > 0) {
+        pppos_input(ppp, buf, (int) len);
+    }
+    sys_check_timeouts();
+}
+
+static int ppp_start(void) {
+    if (ppp) {
+        return 0;
+    }
+    lwip_init();
+    ppp = pppos_create(&ppp_netif, ppp_output_cb, ppp_status_cb, NULL);
+    if (!ppp) {
+        net_log(L_ERROR, "could not create PPP control block");
+        return -1;
+    }
+    ppp_set_default(ppp);
+    ppp_set_usepeerdns(ppp, 1);
+    if (ppp_connect(ppp, 0) != ERR_OK) {
+        net_log(L_ERROR, "could not start PPP negotiation");
+        return -1;
+    }
+    return 0;
+}
+
+static void free_rx_data(net_ctx_t *ctx) {
+    while (ctx->udp_rx_count) {
+        pbuf_free(ctx->udp_rx[ctx->udp_rx_head]);
+        ctx->udp_rx_head = (ctx->udp_rx_head + 1) % UDP_RX_QUEUE_LEN;
+        ctx->udp_rx_count--;
+    }
+    ctx->udp_rx_head = 0;
+    if (ctx->tcp_rx) {
+        pbuf_free(ctx->tcp_rx);
+        ctx->tcp_rx = NULL;
+    }
+}
+
+static void udp_recv_cb(void *arg,
+                        struct udp_pcb *pcb,
+                        struct pbuf *p,
+                        const ip_addr_t *addr,
+                        u16_t port) {
+    (void) pcb;
+    (void) addr;
+    (void) port;
+    net_ctx_t *ctx = (net_ctx_t *) arg;
+    if (ctx->udp_rx_count >= UDP_RX_QUEUE_LEN) {
+        net_log(L_WARNING, "UDP RX queue full, datagram dropped");
+        pbuf_free(p);
+        return;
+    }
+    ctx->udp_rx[(ctx->udp_rx_head + ctx->udp_rx_count) % UDP_RX_QUEUE_LEN] =
+            p;
+    ctx->udp_rx_count++;
+}
+
+static err_t
+tcp_recv_cb(void *arg, struct tcp_pcb *pcb, struct pbuf *p, err_t err) {
+    (void) pcb;
+    net_ctx_t *ctx = (net_ctx_t *) arg;
+    if (!p) {
+        ctx->tcp_peer_closed = true;
+        return ERR_OK;
+    }
+    if (err != ERR_OK) {
+        pbuf_free(p);
+        return err;
+    }
+    if (ctx->tcp_rx) {
+        pbuf_cat(ctx->tcp_rx, p);
+    } else {
+        ctx->tcp_rx = p;
+    }
+    return ERR_OK;
+}
+
+static void tcp_err_cb(void *arg, err_t err) {
+    net_ctx_t *ctx = (net_ctx_t *) arg;
+    net_log(L_WARNING, "TCP connection error: %d", err);
+    // the PCB has already been freed by lwIP
+    ctx->pcb.tcp = NULL;
+    ctx->tcp_error = true;
+    if (ctx->connect_state == CONNECT_STATE_TCP_HANDSHAKE
+            || ctx->connect_state == CONNECT_STATE_TCP_CONNECTED) {
+        ctx->connect_state = CONNECT_STATE_FAILED;
+    }
+}
+
+static err_t tcp_connected_cb(void *arg, struct tcp_pcb *pcb, err_t err) {
+    (void) pcb;
+    net_ctx_t *ctx = (net_ctx_t *) arg;
+    ctx->connect_state =
+            err == ERR_OK ? CONNECT_STATE_TCP_CONNECTED : CONNECT_STATE_FAILED;
+    if (err == ERR_OK) {
+        ctx->state = ANJ_NET_SOCKET_STATE_CONNECTED;
+    }
+    return ERR_OK;
+}
+
+static void dns_found_cb(const char *name, const ip_addr_t *addr, void *arg) {
+    net_ctx_t *ctx = (net_ctx_t *) arg;
+    if (ctx->connect_state != CONNECT_STATE_RESOLVING) {
+        // connection attempt abandoned in the meantime
+        return;
+    }
+    if (!addr) {
+        net_log(L_ERROR, "could not resolve %s", name);
+        ctx->connect_state = CONNECT_STATE_FAILED;
+        return;
+    }
+    ip_addr_copy(ctx->remote_addr, *addr);
+    ctx->connect_state = CONNECT_STATE_RESOLVED;
+}
+
+static u8_t dns_addrtype(const net_ctx_t *ctx) {
+    switch (ctx->af_setting) {
+    case ANJ_NET_AF_SETTING_FORCE_INET4: {
+        return LWIP_DNS_ADDRTYPE_IPV4;
+    }
+    case ANJ_NET_AF_SETTING_FORCE_INET6: {
+        return LWIP_DNS_ADDRTYPE_IPV6;
+    }
+    default: { return LWIP_DNS_ADDRTYPE_IPV4_IPV6; }
+    }
+}
+
+static int net_create_ctx(net_ctx_t **ctx,
+                          const anj_net_config_t *config,
+                          bool is_tcp) {
+    if (ppp_start()) {
+        return -1;
+    }
+    for (size_t i = 0; i < ANJ_ARRAY_SIZE(ctx_storage); i++) {
+        if (!ctx_storage[i].used) {
+            ctx_storage[i] = (net_ctx_t) {
+                .used = true,
+                .is_tcp = is_tcp,
+                .state = ANJ_NET_SOCKET_STATE_CLOSED,
+                .af_setting = config->raw_socket_config.af_setting
+            };
+            *ctx = &ctx_storage[i];
+            return 0;
+        }
+    }
+    return -1;
+}
+
+static int open_pcb(net_ctx_t *ctx) {
+    u8_t type = IP_GET_TYPE(&ctx->remote_addr);
+    u16_t local_port = ctx->reuse_port ? ctx->last_local_port : 0;
+    ctx->reuse_port = false;
+    err_t err;
+    if (ctx->is_tcp) {
+        if (!(ctx->pcb.tcp = tcp_new_ip_type(type))) {
+            return -1;
+        }
+        tcp_arg(ctx->pcb.tcp, ctx);
+        tcp_recv(ctx->pcb.tcp, tcp_recv_cb);
+        tcp_err(ctx->pcb.tcp, tcp_err_cb);
+        if ((err = tcp_bind(ctx->pcb.tcp, IP_ANY_TYPE, local_port))
+                == ERR_OK) {
+            ctx->last_local_port = ctx->pcb.tcp->local_port;
+            ctx->connect_state = CONNECT_STATE_TCP_HANDSHAKE;
+            err = tcp_connect(ctx->pcb.tcp, &ctx->remote_addr,
+                              ctx->remote_port, tcp_connected_cb);
+        }
+    } else {
+        if (!(ctx->pcb.udp = udp_new_ip_type(type))) {
+            return -1;
+        }
+        udp_recv(ctx->pcb.udp, udp_recv_cb, ctx);
+        if ((err = udp_bind(ctx->pcb.udp, IP_ANY_TYPE, local_port))
+                == ERR_OK) {
+            ctx->last_local_port = ctx->pcb.udp->local_port;
+            err = udp_connect(ctx->pcb.udp, &ctx->remote_addr,
+                              ctx->remote_port);
+        }
+        if (err == ERR_OK) {
+            ctx->connect_state = CONNECT_STATE_IDLE;
+            ctx->state = ANJ_NET_SOCKET_STATE_CONNECTED;
+        }
+    }
+    if (err != ERR_OK) {
+        net_log(L_ERROR, "could not open socket, error: %d", err);
+        return -1;
+    }
+    return 0;
+}
+
+static int
+net_connect(net_ctx_t *ctx, const char *hostname, const char *port_str) {
+    ppp_poll();
+    switch (ctx->connect_state) {
+    case CONNECT_STATE_IDLE: {
+        if (ctx->state != ANJ_NET_SOCKET_STATE_CLOSED) {
+            return -1;
+        }
+        char *endptr;
+        unsigned long port = strtoul(port_str, &endptr, 10);
+        if (!*port_str || *endptr || port > UINT16_MAX) {
+            return -1;
+        }
+        ctx->remote_port = (u16_t) port;
+        ctx->connect_state = CONNECT_STATE_WAIT_LINK;
+        return ANJ_NET_EINPROGRESS;
+    }
+    case CONNECT_STATE_WAIT_LINK: {
+        if (!ppp_link_up) {
+            return ANJ_NET_EINPROGRESS;
+        }
+        ctx->connect_state = CONNECT_STATE_RESOLVING;
+        err_t err = dns_gethostbyname_addrtype(hostname, &ctx->remote_addr,
+                                               dns_found_cb, ctx,
+                                               dns_addrtype(ctx));
+        if (err == ERR_INPROGRESS) {
+            return ANJ_NET_EINPROGRESS;
+        }
+        if (err != ERR_OK) {
+            ctx->connect_state = CONNECT_STATE_IDLE;
+            return -1;
+        }
+        // address literal or cached entry
+        ctx->connect_state = CONNECT_STATE_RESOLVED;
+        return ANJ_NET_EINPROGRESS;
+    }
+    case CONNECT_STATE_RESOLVING:
+    case CONNECT_STATE_TCP_HANDSHAKE: {
+        return ANJ_NET_EINPROGRESS;
+    }
+    case CONNECT_STATE_TCP_CONNECTED: {
+        ctx->connect_state = CONNECT_STATE_IDLE;
+        return 0;
+    }
+    case CONNECT_STATE_RESOLVED: {
+        if (open_pcb(ctx)) {
+            ctx->connect_state = CONNECT_STATE_FAILED;
+            break;
+        }
+        return ctx->connect_state == CONNECT_STATE_IDLE ? 0
+                                                        : ANJ_NET_EINPROGRESS;
+    }
+    default: { break; }
+    }
+    // connection failed, the PCB (if any) is released by close
+    ctx->connect_state = CONNECT_STATE_IDLE;
+    return -1;
+}
+
+static int net_get_inner_mtu(net_ctx_t *ctx, int32_t *out_value) {
+    if (!ppp_link_up || !ctx->pcb.udp) {
+        return -1;
+    }
+    int32_t headers = IP_IS_V6(&ctx->remote_addr) ? NET_IPV6_HEADER_LEN
+                                                  : NET_IPV4_HEADER_LEN;
+    headers += ctx->is_tcp ? NET_TCP_HEADER_LEN : NET_UDP_HEADER_LEN;
+    *out_value = (int32_t) ppp_netif.mtu - headers;
+    return 0;
+}
+
+static int net_send(net_ctx_t *ctx,
+                    size_t *bytes_sent,
+                    const uint8_t *buf,
+                    size_t length) {
+    ppp_poll();
+    if (ctx->state != ANJ_NET_SOCKET_STATE_CONNECTED) {
+        return -1;
+    }
+    if (ctx->is_tcp) {
+        if (ctx->tcp_error || !ctx->pcb.tcp) {
+            return -1;
+        }
+        size_t to_send = ANJ_MIN(length, (size_t) tcp_sndbuf(ctx->pcb.tcp));
+        if (!to_send) {
+            return ANJ_NET_EAGAIN;
+        }
+        err_t err = tcp_write(ctx->pcb.tcp, buf, (u16_t) to_send,
+                              TCP_WRITE_FLAG_COPY);
+        if (err == ERR_MEM) {
+            return ANJ_NET_EAGAIN;
+        }
+        if (err != ERR_OK || tcp_output(ctx->pcb.tcp) != ERR_OK) {
+            return -1;
+        }
+        *bytes_sent = to_send;
+        return 0;
+    }
+
+    int32_t mtu;
+    if (net_get_inner_mtu(ctx, &mtu)) {
+        return -1;
+    }
+    if (length > (size_t) mtu) {
+        return ANJ_NET_EMSGSIZE;
+    }
+    struct pbuf *p = pbuf_alloc(PBUF_TRANSPORT, (u16_t) length, PBUF_RAM);
+    if (!p) {
+        return ANJ_NET_EAGAIN;
+    }
+    memcpy(p->payload, buf, length);
+    err_t err = udp_send(ctx->pcb.udp, p);
+    pbuf_free(p);
+    if (err != ERR_OK) {
+        return -1;
+    }
+    *bytes_sent = length;
+    return 0;
+}
+
+static int
+net_recv(net_ctx_t *ctx, size_t *bytes_received, uint8_t *buf, size_t length) {
+    ppp_poll();
+    if (ctx->state != ANJ_NET_SOCKET_STATE_CONNECTED
+            && ctx->state != ANJ_NET_SOCKET_STATE_SHUTDOWN) {
+        return -1;
+    }
+    if (ctx->is_tcp) {
+        if (!ctx->tcp_rx) {
+            if (ctx->tcp_peer_closed) {
+                *bytes_received = 0;
+                return 0;
+            }
+            return ctx->tcp_error ? -1 : ANJ_NET_EAGAIN;
+        }
+        u16_t len = pbuf_copy_partial(
+                ctx->tcp_rx, buf, (u16_t) ANJ_MIN(length, UINT16_MAX), 0);
+        ctx->tcp_rx = pbuf_free_header(ctx->tcp_rx, len);
+        if (ctx->pcb.tcp) {
+            tcp_recved(ctx->pcb.tcp, len);
+        }
+        *bytes_received = len;
+        return 0;
+    }
+
+    if (!ctx->udp_rx_count) {
+        return ANJ_NET_EAGAIN;
+    }
+    struct pbuf *p = ctx->udp_rx[ctx->udp_rx_head];
+    ctx->udp_rx_head = (ctx->udp_rx_head + 1) % UDP_RX_QUEUE_LEN;
+    ctx->udp_rx_count--;
+    *bytes_received = pbuf_copy_partial(
+            p, buf, (u16_t) ANJ_MIN(length, UINT16_MAX), 0);
+    bool truncated = p->tot_len > length;
+    pbuf_free(p);
+    return truncated ? ANJ_NET_EMSGSIZE : 0;
+}
+
+static void release_pcb(net_ctx_t *ctx) {
+    if (ctx->is_tcp) {
+        if (ctx->pcb.tcp) {
+            tcp_arg(ctx->pcb.tcp, NULL);
+            tcp_recv(ctx->pcb.tcp, NULL);
+            tcp_err(ctx->pcb.tcp, NULL);
+            if (tcp_close(ctx->pcb.tcp) != ERR_OK) {
+                tcp_abort(ctx->pcb.tcp);
+            }
+        }
+    } else if (ctx->pcb.udp) {
+        udp_remove(ctx->pcb.udp);
+    }
+    ctx->pcb.udp = NULL;
+    free_rx_data(ctx);
+    ctx->tcp_peer_closed = false;
+    ctx->tcp_error = false;
+}
+
+static int net_shutdown(net_ctx_t *ctx) {
+    if (ctx->is_tcp && ctx->pcb.tcp
+            && ctx->state == ANJ_NET_SOCKET_STATE_CONNECTED) {
+        tcp_shutdown(ctx->pcb.tcp, 0, 1);
+    }
+    ctx->state = ANJ_NET_SOCKET_STATE_SHUTDOWN;
+    return 0;
+}
+
+static int net_close(net_ctx_t *ctx) {
+    // NOTE: abandons a pending DNS query or TCP handshake as well
+    release_pcb(ctx);
+    ctx->connect_state = CONNECT_STATE_IDLE;
+    ctx->state = ANJ_NET_SOCKET_STATE_CLOSED;
+    return 0;
+}
+
+static int net_get_state(net_ctx_t *ctx, anj_net_socket_state_t *out_value) {
+    *out_value = ctx->state;
+    return 0;
+}
+
+static int net_reuse_last_port(net_ctx_t *ctx) {
+    if (!ctx->last_local_port) {
+        return -1;
+    }
+    ctx->reuse_port = true;
+    return 0;
+}
+
+static int net_cleanup_ctx(net_ctx_t **ctx) {
+    net_close(*ctx);
+    (*ctx)->used = false;
+    *ctx = NULL;
+    return 0;
+}
+
+static int net_queue_mode_rx_off(anj_net_ctx_t *ctx) {
+    (void) ctx;
+    return ANJ_NET_OK;
+}
+
+#ifdef ANJ_NET_WITH_UDP
+int anj_udp_create_ctx(anj_net_ctx_t **ctx, const anj_net_config_t *config) {
+    return net_create_ctx((net_ctx_t **) ctx, config, false);
+}
+
+int anj_udp_cleanup_ctx(anj_net_ctx_t **ctx) {
+    return net_cleanup_ctx((net_ctx_t **) ctx);
+}
+
+int anj_udp_connect(anj_net_ctx_t *ctx,
+                    const char *hostname,
+                    const char *port) {
+    return net_connect((net_ctx_t *) ctx, hostname, port);
+}
+
+int anj_udp_send(anj_net_ctx_t *ctx,
+                 size_t *bytes_sent,
+                 const uint8_t *buf,
+                 size_t length) {
+    return net_stats_sent(NET_STATS_UDP,
+                          net_send((net_ctx_t *) ctx, bytes_sent, buf, length),
+                          bytes_sent);
+}
+
+int anj_udp_recv(anj_net_ctx_t *ctx,
+                 size_t *bytes_received,
+                 uint8_t *buf,
+                 size_t length) {
+    return net_stats_received(
+            NET_STATS_UDP,
+            net_recv((net_ctx_t *) ctx, bytes_received, buf, length),
+            bytes_received);
+}
+
+int anj_udp_shutdown(anj_net_ctx_t *ctx) {
+    return net_shutdown((net_ctx_t *) ctx);
+}
+
+int anj_udp_close(anj_net_ctx_t *ctx) {
+    return net_close((net_ctx_t *) ctx);
+}
+
+int anj_udp_get_state(anj_net_ctx_t *ctx, anj_net_socket_state_t *out_value) {
+    return net_get_state((net_ctx_t *) ctx, out_value);
+}
+
+int anj_udp_get_inner_mtu(anj_net_ctx_t *ctx, int32_t *out_value) {
+    return net_get_inner_mtu((net_ctx_t *) ctx, out_value);
+}
+
+int anj_udp_reuse_last_port(anj_net_ctx_t *ctx) {
+    return net_reuse_last_port((net_ctx_t *) ctx);
+}
+
+int anj_udp_queue_mode_rx_off(anj_net_ctx_t *ctx) {
+    return net_queue_mode_rx_off(ctx);
+}
+#endif // ANJ_NET_WITH_UDP
+
+#ifdef ANJ_NET_WITH_TCP
+int anj_tcp_create_ctx(anj_net_ctx_t **ctx, const anj_net_config_t *config) {
+    return net_create_ctx((net_ctx_t **) ctx, config, true);
+}
+
+int anj_tcp_cleanup_ctx(anj_net_ctx_t **ctx) {
+    return net_cleanup_ctx((net_ctx_t **) ctx);
+}
+
+int anj_tcp_connect(anj_net_ctx_t *ctx,
+                    const char *hostname,
+                    const char *port) {
+    return net_connect((net_ctx_t *) ctx, hostname, port);
+}
+
+int anj_tcp_send(anj_net_ctx_t *ctx,
+                 size_t *bytes_sent,
+                 const uint8_t *buf,
+                 size_t length) {
+    return net_stats_sent(NET_STATS_TCP,
+                          net_send((net_ctx_t *) ctx, bytes_sent, buf, length),
+                          bytes_sent);
+}
+
+int anj_tcp_recv(anj_net_ctx_t *ctx,
+                 size_t *bytes_received,
+                 uint8_t *buf,
+                 size_t length) {
+    return net_stats_received(
+            NET_STATS_TCP,
+            net_recv((net_ctx_t *) ctx, bytes_received, buf, length),
+            bytes_received);
+}
+
+int anj_tcp_shutdown(anj_net_ctx_t *ctx) {
+    return net_shutdown((net_ctx_t *) ctx);
+}
+
+int anj_tcp_close(anj_net_ctx_t *ctx) {
+    return net_close((net_ctx_t *) ctx);
+}
+
+int anj_tcp_get_state(anj_net_ctx_t *ctx, anj_net_socket_state_t *out_value) {
+    return net_get_state((net_ctx_t *) ctx, out_value);
+}
+
+int anj_tcp_get_inner_mtu(anj_net_ctx_t *ctx, int32_t *out_value) {
+    return net_get_inner_mtu((net_ctx_t *) ctx, out_value);
+}
+
+int anj_tcp_reuse_last_port(anj_net_ctx_t *ctx) {
+    return net_reuse_last_port((net_ctx_t *) ctx);
+}
+
+int anj_tcp_queue_mode_rx_off(anj_net_ctx_t *ctx) {
+    return net_queue_mode_rx_off(ctx);
+}
+#endif // ANJ_NET_WITH_TCP
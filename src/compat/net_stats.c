@@ -0,0 +1,90 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#include <inttypes.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <anj/compat/net/anj_net_api.h>
+#include <anj/log.h>
+#include <anj/utils.h>
+
+#include "modem/modem.h"
+
+#include "net_stats.h"
+
+#define net_log(...) anj_log(net, __VA_ARGS__)
+
+static net_stats_t stats[_NET_STATS_TRANSPORT_COUNT];
+
+static void count_packet(net_stats_dir_t *dir, size_t len) {
+    dir->bytes += len;
+    dir->packets++;
+    dir->max_packet_size = ANJ_MAX(dir->max_packet_size, (uint32_t) len);
+}
+
+int net_stats_sent(net_stats_transport_t transport,
+                   int result,
+                   const size_t *bytes_sent) {
+    net_stats_dir_t *tx = &stats[transport].tx;
+    if (result == 0) {
+        count_packet(tx, *bytes_sent);
+    } else if (result != ANJ_NET_EAGAIN && result != ANJ_NET_EINPROGRESS) {
+        tx->errors++;
+    }
+    return result;
+}
+
+int net_stats_received(net_stats_transport_t transport,
+                       int result,
+                       const size_t *bytes_received) {
+    net_stats_dir_t *rx = &stats[transport].rx;
+    if (result == 0) {
+        // zero-length TCP reads only signal the end of stream
+        if (*bytes_received) {
+            count_packet(rx, *bytes_received);
+        }
+    } else if (result == ANJ_NET_EMSGSIZE) {
+        // the truncated data is still passed to Anjay Lite
+        count_packet(rx, *bytes_received);
+        rx->truncated++;
+    } else if (result != ANJ_NET_EAGAIN && result != ANJ_NET_EINPROGRESS) {
+        rx->errors++;
+    }
+    return result;
+}
+
+const net_stats_t *net_stats(net_stats_transport_t transport) {
+    return &stats[transport];
+}
+
+void net_stats_reset(void) {
+    memset(stats, 0, sizeof(stats));
+}
+
+static void log_dir(const char *transport,
+                    const char *direction,
+                    const net_stats_dir_t *dir) {
+    net_log(L_INFO,
+            "%s %s: %" PRIu32 " packets, %" PRIu32 " bytes, max %" PRIu32
+            ", %" PRIu32 " errors, %" PRIu32 " truncated",
+            transport, direction, dir->packets, (uint32_t) dir->bytes,
+            dir->max_packet_size, dir->errors, dir->truncated);
+}
+
+void net_stats_log(void) {
+    log_dir("UDP", "TX", &stats[NET_STATS_UDP].tx);
+    log_dir("UDP", "RX", &stats[NET_STATS_UDP].rx);
+    log_dir("TCP", "TX", &stats[NET_STATS_TCP].tx);
+    log_dir("TCP", "RX", &stats[NET_STATS_TCP].rx);
+    const modem_socket_stats_t *modem_stats = modem_socket_stats();
+    net_log(L_INFO, "modem RX dropped: %" PRIu32 " packets, %" PRIu32 " bytes",
+            modem_stats->rx_dropped, modem_stats->rx_dropped_bytes);
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#ifndef NET_STATS_H
+#define NET_STATS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum {
+    NET_STATS_UDP,
+    NET_STATS_TCP,
+    _NET_STATS_TRANSPORT_COUNT
+} net_stats_transport_t;
+
+typedef struct {
+    // bytes passed to/from Anjay Lite, i.e. DTLS records or plain CoAP
+    // messages, without IP/UDP/TCP headers
+    uint64_t bytes;
+    // datagrams for UDP, successful send/recv calls for TCP
+    uint32_t packets;
+    uint32_t max_packet_size;
+    // for TX: failed sends, including messages over the MTU; for RX: receive
+    // errors other than truncation
+    uint32_t errors;
+    // RX only: datagrams that did not fit in the receive buffer
+    uint32_t truncated;
+} net_stats_dir_t;
+
+typedef struct {
+    net_stats_dir_t tx;
+    net_stats_dir_t rx;
+} net_stats_t;
+
+/**
+ * Accounts for the result of an anj_*_send() call and returns @p result, so
+ * that the call can be wrapped:
+ *
+ *     return net_stats_sent(NET_STATS_UDP, net_send(...), bytes_sent);
+ *
+ * Calls that are still in progress are not counted.
+ */
+int net_stats_sent(net_stats_transport_t transport,
+                   int result,
+                   const size_t *bytes_sent);
+
+/**
+ * Same as @ref net_stats_sent, for anj_*_recv() calls.
+ */
+int net_stats_received(net_stats_transport_t transport,
+                       int result,
+                       const size_t *bytes_received);
+
+const net_stats_t *net_stats(net_stats_transport_t transport);
+
+/**
+ * Zeroes the counters of all transports.
+ */
+void net_stats_reset(void);
+
+/**
+ * Logs all counters, including modem layer drops.
+ */
+void net_stats_log(void);
+
+#endif // NET_STATS_H
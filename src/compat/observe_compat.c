@@ -0,0 +1,108 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <anj/core.h>
+#include <anj/defs.h>
+#include <anj/utils.h>
+
+#include "observe_compat.h"
+
+#ifdef ANJ_WITH_OBSERVE
+
+#    define OBSERVE_CTX(Member) (((anj_t *) NULL)->observe_ctx.Member)
+
+// NOTE: if any of these fail after an Anjay Lite update, check the members
+// used below against its observe context before adjusting them
+ANJ_STATIC_ASSERT(ANJ_ARRAY_SIZE(OBSERVE_CTX(observations))
+                          == ANJ_OBSERVE_MAX_OBSERVATIONS_NUMBER,
+                  observations_layout_changed);
+ANJ_STATIC_ASSERT(sizeof(OBSERVE_CTX(observations)[0].path)
+                          == sizeof(anj_uri_path_t),
+                  observation_path_layout_changed);
+ANJ_STATIC_ASSERT(ANJ_ARRAY_SIZE(OBSERVE_CTX(attributes_storage))
+                          == ANJ_OBSERVE_MAX_WRITE_ATTRIBUTES_NUMBER,
+                  attributes_storage_layout_changed);
+ANJ_STATIC_ASSERT(sizeof(OBSERVE_CTX(attributes_storage)[0].path)
+                          == sizeof(anj_uri_path_t),
+                  attributes_path_layout_changed);
+ANJ_STATIC_ASSERT(sizeof(OBSERVE_CTX(attributes_storage)[0].attr.step)
+                                  == sizeof(double)
+                          && sizeof(OBSERVE_CTX(attributes_storage)[0]
+                                            .attr.greater_than)
+                                     == sizeof(double)
+                          && sizeof(OBSERVE_CTX(attributes_storage)[0]
+                                            .attr.less_than)
+                                     == sizeof(double),
+                  attributes_layout_changed);
+
+static bool path_is_prefix(const anj_uri_path_t *prefix,
+                           const anj_uri_path_t *path) {
+    if (prefix->uri_len > path->uri_len) {
+        return false;
+    }
+    for (uint8_t i = 0; i < prefix->uri_len; i++) {
+        if (prefix->ids[i] != path->ids[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool observe_compat_is_observed(anj_t *anj, const anj_uri_path_t *path) {
+    for (size_t i = 0; i < ANJ_OBSERVE_MAX_OBSERVATIONS_NUMBER; i++) {
+        const _anj_observation_t *observation =
+                &anj->observe_ctx.observations[i];
+        // unused entries have no SSID
+        if (observation->ssid && path_is_prefix(&observation->path, path)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void observe_compat_get_attrs(anj_t *anj,
+                              const anj_uri_path_t *path,
+                              observe_compat_attrs_t *out_attrs) {
+    *out_attrs = (observe_compat_attrs_t) { 0 };
+    // object level attributes are visited first, so that the more specific
+    // ones override them
+    for (uint8_t level = 1; level <= path->uri_len; level++) {
+        for (size_t i = 0; i < ANJ_OBSERVE_MAX_WRITE_ATTRIBUTES_NUMBER; i++) {
+            const _anj_observe_attr_storage_t *storage =
+                    &anj->observe_ctx.attributes_storage[i];
+            if (storage->path.uri_len != level
+                    || !path_is_prefix(&storage->path, path)) {
+                continue;
+            }
+            const _anj_attr_notification_t *attr = &storage->attr;
+            if (attr->has_step) {
+                out_attrs->has_step = true;
+                out_attrs->step = attr->step;
+            }
+            if (attr->has_greater_than) {
+                out_attrs->has_greater_than = true;
+                out_attrs->greater_than = attr->greater_than;
+            }
+            if (attr->has_less_than) {
+                out_attrs->has_less_than = true;
+                out_attrs->less_than = attr->less_than;
+            }
+            if (attr->has_min_period) {
+                out_attrs->has_min_period = true;
+                out_attrs->min_period = attr->min_period;
+            }
+        }
+    }
+}
+
+#endif // ANJ_WITH_OBSERVE
@@ -0,0 +1,52 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#ifndef OBSERVE_COMPAT_H
+#define OBSERVE_COMPAT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <anj/core.h>
+#include <anj/defs.h>
+
+/*
+ * Observations and notification attributes set by the servers. Anjay Lite
+ * has no public API to query them, so this is the only place that looks into
+ * its private observe context; the layout it relies on is checked at compile
+ * time in observe_compat.c.
+ */
+
+#ifdef ANJ_WITH_OBSERVE
+typedef struct {
+    bool has_step;
+    double step;
+    bool has_greater_than;
+    double greater_than;
+    bool has_less_than;
+    double less_than;
+    bool has_min_period;
+    uint32_t min_period;
+} observe_compat_attrs_t;
+
+/**
+ * @returns true if any server observes @p path or one of its parents.
+ */
+bool observe_compat_is_observed(anj_t *anj, const anj_uri_path_t *path);
+
+/**
+ * Collects the notification attributes set on @p path and its parents; the
+ * ones set on more specific paths take precedence.
+ */
+void observe_compat_get_attrs(anj_t *anj,
+                              const anj_uri_path_t *path,
+                              observe_compat_attrs_t *out_attrs);
+#endif // ANJ_WITH_OBSERVE
+
+#endif // OBSERVE_COMPAT_H
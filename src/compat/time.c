@@ -7,17 +7,19 @@
  * See the attached LICENSE file for details.
  */
 
+#include <stdint.h>
+
 #include <anj/compat/time.h>
 
-#include "stm32u3xx_hal.h"
+#include "timebase.h"
 
-// NOTE: consider adding support for NTP sync for real time and to support
-// rollover of HAL_GetTick() after about 49 days
+// NOTE: consider adding support for NTP sync for real time
 
 anj_time_monotonic_t anj_time_monotonic_now(void) {
-    return anj_time_monotonic_new(HAL_GetTick(), ANJ_TIME_UNIT_MS);
+    return anj_time_monotonic_new((int64_t) timebase_now_us(),
+                                  ANJ_TIME_UNIT_US);
 }
 
 anj_time_real_t anj_time_real_now(void) {
-    return anj_time_real_new(HAL_GetTick(), ANJ_TIME_UNIT_MS);
+    return anj_time_real_new((int64_t) timebase_now_us(), ANJ_TIME_UNIT_US);
 }
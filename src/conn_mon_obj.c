@@ -0,0 +1,326 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <anj/core.h>
+#include <anj/defs.h>
+#include <anj/dm/core.h>
+#include <anj/utils.h>
+
+#include <stm32u3xx_hal.h>
+
+#include "modem/modem_radio.h"
+
+#include "conn_mon_obj.h"
+
+#define CONN_MON_OID 4
+#define CONN_MON_RESOURCES_COUNT 11
+
+// The poll interval is derived from the number of reads in the last window,
+// which grows with the number of observations and with their frequency
+#define CONN_MON_DEMAND_WINDOW_MS (10 * 60 * 1000)
+#define CONN_MON_POLL_IDLE_MS (10 * 60 * 1000)
+#define CONN_MON_POLL_MIN_MS (15 * 1000)
+
+#ifndef CONFIG_APN
+#    define CONFIG_APN "internet"
+#endif // CONFIG_APN
+
+enum {
+    RID_NETWORK_BEARER = 0,
+    RID_AVAILABLE_NETWORK_BEARER = 1,
+    RID_RADIO_SIGNAL_STRENGTH = 2,
+    RID_LINK_QUALITY = 3,
+    RID_IP_ADDRESSES = 4,
+    RID_APN = 7,
+    RID_CELL_ID = 8,
+    RID_SMNC = 9,
+    RID_SMCC = 10,
+    RID_SIGNAL_SNR = 11,
+    RID_LAC = 12,
+};
+
+enum {
+    RID_NETWORK_BEARER_IDX = 0,
+    RID_AVAILABLE_NETWORK_BEARER_IDX,
+    RID_RADIO_SIGNAL_STRENGTH_IDX,
+    RID_LINK_QUALITY_IDX,
+    RID_IP_ADDRESSES_IDX,
+    RID_APN_IDX,
+    RID_CELL_ID_IDX,
+    RID_SMNC_IDX,
+    RID_SMCC_IDX,
+    RID_SIGNAL_SNR_IDX,
+    RID_LAC_IDX,
+    _RID_LAST
+};
+
+ANJ_STATIC_ASSERT(_RID_LAST == CONN_MON_RESOURCES_COUNT,
+                  conn_mon_resource_count_mismatch);
+
+// Network Bearer values, as defined by the object
+enum {
+    BEARER_GSM = 0,
+    BEARER_LTE_FDD = 6,
+    BEARER_NB_IOT = 7,
+};
+
+// bearers supported by BG96
+static const int64_t AVAILABLE_BEARERS[] = { BEARER_LTE_FDD, BEARER_NB_IOT,
+                                             BEARER_GSM };
+static const anj_riid_t AVAILABLE_BEARERS_RIIDS[] = { 0, 1, 2 };
+static const anj_riid_t SINGLE_RIID[] = { 0 };
+// no instance until the address is known
+static anj_riid_t ip_addresses_riids[] = { ANJ_ID_INVALID };
+
+static const anj_dm_res_t RES[CONN_MON_RESOURCES_COUNT] = {
+    [RID_NETWORK_BEARER_IDX] = {
+        .rid = RID_NETWORK_BEARER,
+        .type = ANJ_DATA_TYPE_INT,
+        .kind = ANJ_DM_RES_R
+    },
+    [RID_AVAILABLE_NETWORK_BEARER_IDX] = {
+        .rid = RID_AVAILABLE_NETWORK_BEARER,
+        .type = ANJ_DATA_TYPE_INT,
+        .kind = ANJ_DM_RES_RM,
+        .max_inst_count = ANJ_ARRAY_SIZE(AVAILABLE_BEARERS_RIIDS),
+        .insts = AVAILABLE_BEARERS_RIIDS
+    },
+    [RID_RADIO_SIGNAL_STRENGTH_IDX] = {
+        .rid = RID_RADIO_SIGNAL_STRENGTH,
+        .type = ANJ_DATA_TYPE_INT,
+        .kind = ANJ_DM_RES_R
+    },
+    [RID_LINK_QUALITY_IDX] = {
+        .rid = RID_LINK_QUALITY,
+        .type = ANJ_DATA_TYPE_INT,
+        .kind = ANJ_DM_RES_R
+    },
+    [RID_IP_ADDRESSES_IDX] = {
+        .rid = RID_IP_ADDRESSES,
+        .type = ANJ_DATA_TYPE_STRING,
+        .kind = ANJ_DM_RES_RM,
+        .max_inst_count = ANJ_ARRAY_SIZE(ip_addresses_riids),
+        .insts = ip_addresses_riids
+    },
+    [RID_APN_IDX] = {
+        .rid = RID_APN,
+        .type = ANJ_DATA_TYPE_STRING,
+        .kind = ANJ_DM_RES_RM,
+        .max_inst_count = ANJ_ARRAY_SIZE(SINGLE_RIID),
+        .insts = SINGLE_RIID
+    },
+    [RID_CELL_ID_IDX] = {
+        .rid = RID_CELL_ID,
+        .type = ANJ_DATA_TYPE_INT,
+        .kind = ANJ_DM_RES_R
+    },
+    [RID_SMNC_IDX] = {
+        .rid = RID_SMNC,
+        .type = ANJ_DATA_TYPE_INT,
+        .kind = ANJ_DM_RES_R
+    },
+    [RID_SMCC_IDX] = {
+        .rid = RID_SMCC,
+        .type = ANJ_DATA_TYPE_INT,
+        .kind = ANJ_DM_RES_R
+    },
+    [RID_SIGNAL_SNR_IDX] = {
+        .rid = RID_SIGNAL_SNR,
+        .type = ANJ_DATA_TYPE_INT,
+        .kind = ANJ_DM_RES_R
+    },
+    [RID_LAC_IDX] = {
+        .rid = RID_LAC,
+        .type = ANJ_DATA_TYPE_INT,
+        .kind = ANJ_DM_RES_R
+    }
+};
+
+typedef struct {
+    // values last reported as changed
+    modem_radio_info_t reported;
+    uint32_t window_start_tick;
+    uint32_t reads_in_window;
+    uint32_t last_read_tick;
+} conn_mon_ctx_t;
+
+static conn_mon_ctx_t conn_mon_ctx;
+
+static inline conn_mon_ctx_t *get_ctx(void) {
+    return &conn_mon_ctx;
+}
+
+static int64_t network_bearer(modem_rat_t rat) {
+    switch (rat) {
+    case MODEM_RAT_GSM:
+        return BEARER_GSM;
+    case MODEM_RAT_NBIOT:
+        return BEARER_NB_IOT;
+    default:
+        // BG96 defaults to LTE Cat M1, FDD only
+        return BEARER_LTE_FDD;
+    }
+}
+
+static void notify_changed(anj_t *anj, anj_rid_t rid) {
+    anj_core_data_model_changed(anj,
+                                &ANJ_MAKE_RESOURCE_PATH(CONN_MON_OID, 0, rid),
+                                ANJ_CORE_CHANGE_TYPE_VALUE_CHANGED);
+}
+
+static void report_changes(anj_t *anj, const modem_radio_info_t *info) {
+    modem_radio_info_t *reported = &get_ctx()->reported;
+    if (info->rat != reported->rat) {
+        notify_changed(anj, RID_NETWORK_BEARER);
+    }
+    if (info->signal_strength_dbm != reported->signal_strength_dbm) {
+        notify_changed(anj, RID_RADIO_SIGNAL_STRENGTH);
+    }
+    if (info->rsrq_db != reported->rsrq_db) {
+        notify_changed(anj, RID_LINK_QUALITY);
+    }
+    if (info->sinr_db != reported->sinr_db) {
+        notify_changed(anj, RID_SIGNAL_SNR);
+    }
+    if (info->cell_id != reported->cell_id) {
+        notify_changed(anj, RID_CELL_ID);
+    }
+    if (info->mnc != reported->mnc) {
+        notify_changed(anj, RID_SMNC);
+    }
+    if (info->mcc != reported->mcc) {
+        notify_changed(anj, RID_SMCC);
+    }
+    if (info->area_code != reported->area_code) {
+        notify_changed(anj, RID_LAC);
+    }
+    if (info->ip_valid != reported->ip_valid
+            || strcmp(info->ip_address, reported->ip_address)) {
+        ip_addresses_riids[0] = info->ip_valid ? 0 : ANJ_ID_INVALID;
+        notify_changed(anj, RID_IP_ADDRESSES);
+    }
+    *reported = *info;
+}
+
+static void update_poll_interval(void) {
+    conn_mon_ctx_t *ctx = get_ctx();
+    uint32_t now = HAL_GetTick();
+    if (now - ctx->window_start_tick < CONN_MON_DEMAND_WINDOW_MS) {
+        return;
+    }
+    uint32_t interval = CONN_MON_POLL_IDLE_MS / (1 + ctx->reads_in_window);
+    modem_radio_set_poll_interval(ANJ_MAX(interval, CONN_MON_POLL_MIN_MS));
+    ctx->window_start_tick = now;
+    ctx->reads_in_window = 0;
+}
+
+void conn_mon_obj_update(anj_t *anj) {
+    const modem_radio_info_t *info = modem_radio_info();
+    if (info->generation != get_ctx()->reported.generation) {
+        report_changes(anj, info);
+    }
+    update_poll_interval();
+}
+
+static int res_read(anj_t *anj,
+                    const anj_dm_obj_t *obj,
+                    anj_iid_t iid,
+                    anj_rid_t rid,
+                    anj_riid_t riid,
+                    anj_res_value_t *out_value) {
+    (void) anj;
+    (void) obj;
+    (void) iid;
+
+    conn_mon_ctx_t *ctx = get_ctx();
+    // reads of multiple resources within the same tick, e.g. of the whole
+    // instance, count as one
+    uint32_t now = HAL_GetTick();
+    if (now != ctx->last_read_tick) {
+        ctx->last_read_tick = now;
+        ctx->reads_in_window++;
+    }
+
+    // NOTE: values that were not retrieved yet are reported as 0, as failing
+    // the read would fail reads of the whole object as well
+    const modem_radio_info_t *info = &ctx->reported;
+    switch (rid) {
+    case RID_NETWORK_BEARER:
+        out_value->int_value = network_bearer(info->rat);
+        break;
+    case RID_AVAILABLE_NETWORK_BEARER:
+        if (riid >= ANJ_ARRAY_SIZE(AVAILABLE_BEARERS)) {
+            return ANJ_DM_ERR_NOT_FOUND;
+        }
+        out_value->int_value = AVAILABLE_BEARERS[riid];
+        break;
+    case RID_RADIO_SIGNAL_STRENGTH:
+        out_value->int_value = info->signal_strength_dbm;
+        break;
+    case RID_LINK_QUALITY:
+        out_value->int_value = info->rsrq_db;
+        break;
+    case RID_IP_ADDRESSES:
+        if (!info->ip_valid || riid != 0) {
+            return ANJ_DM_ERR_NOT_FOUND;
+        }
+        out_value->bytes_or_string.data = info->ip_address;
+        break;
+    case RID_APN:
+        out_value->bytes_or_string.data = CONFIG_APN;
+        break;
+    case RID_CELL_ID:
+        out_value->int_value = info->cell_id;
+        break;
+    case RID_SMNC:
+        out_value->int_value = info->mnc;
+        break;
+    case RID_SMCC:
+        out_value->int_value = info->mcc;
+        break;
+    case RID_SIGNAL_SNR:
+        out_value->int_value = info->sinr_db;
+        break;
+    case RID_LAC:
+        out_value->int_value = info->area_code;
+        break;
+    default:
+        return ANJ_DM_ERR_NOT_FOUND;
+    }
+    return 0;
+}
+
+static const anj_dm_handlers_t CONN_MON_OBJ_HANDLERS = {
+    .res_read = res_read,
+};
+
+static const anj_dm_obj_inst_t INST = {
+    .iid = 0,
+    .res_count = CONN_MON_RESOURCES_COUNT,
+    .resources = RES
+};
+
+static const anj_dm_obj_t OBJ = {
+    .oid = CONN_MON_OID,
+    .version = "1.2",
+    .insts = &INST,
+    .handlers = &CONN_MON_OBJ_HANDLERS,
+    .max_inst_count = 1
+};
+
+const anj_dm_obj_t *conn_mon_obj_init(void) {
+    memset(&conn_mon_ctx, 0, sizeof(conn_mon_ctx));
+    conn_mon_ctx.window_start_tick = HAL_GetTick();
+    modem_radio_set_poll_interval(CONN_MON_POLL_IDLE_MS);
+    return &OBJ;
+}
@@ -0,0 +1,30 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#ifndef _CONN_MON_OBJ_H_
+#define _CONN_MON_OBJ_H_
+
+#include <anj/core.h>
+#include <anj/defs.h>
+
+/**
+ * @brief Returns the Connectivity Monitoring Object (/4). Values are served
+ * from the cache of the modem radio poller, so reads never touch the modem.
+ */
+const anj_dm_obj_t *conn_mon_obj_init(void);
+
+/**
+ * @brief Reports values refreshed by the poller as changed and adjusts the
+ * poll rate to how often the object is read.
+ *
+ * @param anj Anjay Lite instance the object is installed in.
+ */
+void conn_mon_obj_update(anj_t *anj);
+
+#endif // _CONN_MON_OBJ_H_
@@ -0,0 +1,309 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <anj/core.h>
+#include <anj/defs.h>
+#include <anj/dm/core.h>
+#include <anj/utils.h>
+
+#include <stm32u3xx_hal.h>
+
+#include "compat/net_stats.h"
+
+#include "conn_stats_obj.h"
+
+#define CONN_STATS_OID 7
+#define CONN_STATS_RESOURCES_COUNT 7
+
+enum {
+    RID_TX_DATA = 2,
+    RID_RX_DATA = 3,
+    RID_MAX_MESSAGE_SIZE = 4,
+    RID_AVERAGE_MESSAGE_SIZE = 5,
+    RID_START = 6,
+    RID_STOP = 7,
+    RID_COLLECTION_PERIOD = 8,
+};
+
+enum {
+    RID_TX_DATA_IDX = 0,
+    RID_RX_DATA_IDX,
+    RID_MAX_MESSAGE_SIZE_IDX,
+    RID_AVERAGE_MESSAGE_SIZE_IDX,
+    RID_START_IDX,
+    RID_STOP_IDX,
+    RID_COLLECTION_PERIOD_IDX,
+    _RID_LAST
+};
+
+ANJ_STATIC_ASSERT(_RID_LAST == CONN_STATS_RESOURCES_COUNT,
+                  conn_stats_resource_count_mismatch);
+
+static const anj_dm_res_t RES[CONN_STATS_RESOURCES_COUNT] = {
+    [RID_TX_DATA_IDX] = {
+        .rid = RID_TX_DATA,
+        .type = ANJ_DATA_TYPE_INT,
+        .kind = ANJ_DM_RES_R
+    },
+    [RID_RX_DATA_IDX] = {
+        .rid = RID_RX_DATA,
+        .type = ANJ_DATA_TYPE_INT,
+        .kind = ANJ_DM_RES_R
+    },
+    [RID_MAX_MESSAGE_SIZE_IDX] = {
+        .rid = RID_MAX_MESSAGE_SIZE,
+        .type = ANJ_DATA_TYPE_INT,
+        .kind = ANJ_DM_RES_R
+    },
+    [RID_AVERAGE_MESSAGE_SIZE_IDX] = {
+        .rid = RID_AVERAGE_MESSAGE_SIZE,
+        .type = ANJ_DATA_TYPE_INT,
+        .kind = ANJ_DM_RES_R
+    },
+    [RID_START_IDX] = {
+        .rid = RID_START,
+        .kind = ANJ_DM_RES_E
+    },
+    [RID_STOP_IDX] = {
+        .rid = RID_STOP,
+        .kind = ANJ_DM_RES_E
+    },
+    [RID_COLLECTION_PERIOD_IDX] = {
+        .rid = RID_COLLECTION_PERIOD,
+        .type = ANJ_DATA_TYPE_INT,
+        .kind = ANJ_DM_RES_RW
+    }
+};
+
+typedef struct {
+    bool collecting;
+    // in seconds, 0 means that the collection lasts until Stop is executed
+    int64_t collection_period;
+    int64_t collection_period_cached;
+    uint32_t start_tick;
+    // counters at the time the collection was stopped
+    net_stats_t stopped[_NET_STATS_TRANSPORT_COUNT];
+} conn_stats_ctx_t;
+
+typedef struct {
+    uint64_t tx_bytes;
+    uint64_t rx_bytes;
+    uint32_t packets;
+    uint32_t max_packet_size;
+} totals_t;
+
+static conn_stats_ctx_t conn_stats_ctx;
+
+static inline conn_stats_ctx_t *get_ctx(void) {
+    return &conn_stats_ctx;
+}
+
+// NOTE: counters are summed over all transports; they cover the DTLS records
+// exchanged with the server, as IP headers are not visible to the client
+static totals_t get_totals(void) {
+    conn_stats_ctx_t *ctx = get_ctx();
+    totals_t totals = { 0 };
+    for (int i = 0; i < _NET_STATS_TRANSPORT_COUNT; i++) {
+        const net_stats_t *stats =
+                ctx->collecting ? net_stats((net_stats_transport_t) i)
+                                : &ctx->stopped[i];
+        totals.tx_bytes += stats->tx.bytes;
+        totals.rx_bytes += stats->rx.bytes;
+        totals.packets += stats->tx.packets + stats->rx.packets;
+        totals.max_packet_size =
+                ANJ_MAX(totals.max_packet_size,
+                        ANJ_MAX(stats->tx.max_packet_size,
+                                stats->rx.max_packet_size));
+    }
+    return totals;
+}
+
+// NOTE: counters change on every message, so notifying about each change would
+// make observations generate traffic on their own; observers get new values
+// only on pmax, or when the collection starts or stops
+static void notify_counters_changed(anj_t *anj) {
+    static const anj_rid_t rids[] = { RID_TX_DATA, RID_RX_DATA,
+                                      RID_MAX_MESSAGE_SIZE,
+                                      RID_AVERAGE_MESSAGE_SIZE };
+    for (size_t i = 0; i < ANJ_ARRAY_SIZE(rids); i++) {
+        anj_core_data_model_changed(anj,
+                                    &ANJ_MAKE_RESOURCE_PATH(CONN_STATS_OID, 0,
+                                                            rids[i]),
+                                    ANJ_CORE_CHANGE_TYPE_VALUE_CHANGED);
+    }
+}
+
+static void start_collection(anj_t *anj) {
+    conn_stats_ctx_t *ctx = get_ctx();
+    net_stats_reset();
+    ctx->collecting = true;
+    ctx->start_tick = HAL_GetTick();
+    notify_counters_changed(anj);
+}
+
+static void stop_collection(anj_t *anj) {
+    conn_stats_ctx_t *ctx = get_ctx();
+    if (!ctx->collecting) {
+        return;
+    }
+    for (int i = 0; i < _NET_STATS_TRANSPORT_COUNT; i++) {
+        ctx->stopped[i] = *net_stats((net_stats_transport_t) i);
+    }
+    ctx->collecting = false;
+    // errors and drops are not a part of the object, log them instead
+    net_stats_log();
+    notify_counters_changed(anj);
+}
+
+void conn_stats_obj_update(anj_t *anj) {
+    conn_stats_ctx_t *ctx = get_ctx();
+    if (ctx->collecting && ctx->collection_period > 0
+            && HAL_GetTick() - ctx->start_tick
+                           >= (uint64_t) ctx->collection_period * 1000) {
+        stop_collection(anj);
+    }
+}
+
+static int res_read(anj_t *anj,
+                    const anj_dm_obj_t *obj,
+                    anj_iid_t iid,
+                    anj_rid_t rid,
+                    anj_riid_t riid,
+                    anj_res_value_t *out_value) {
+    (void) anj;
+    (void) obj;
+    (void) iid;
+    (void) riid;
+
+    totals_t totals = get_totals();
+
+    switch (rid) {
+    case RID_TX_DATA:
+        out_value->int_value = (int64_t) (totals.tx_bytes / 1024);
+        break;
+    case RID_RX_DATA:
+        out_value->int_value = (int64_t) (totals.rx_bytes / 1024);
+        break;
+    case RID_MAX_MESSAGE_SIZE:
+        out_value->int_value = totals.max_packet_size;
+        break;
+    case RID_AVERAGE_MESSAGE_SIZE:
+        out_value->int_value =
+                totals.packets ? (int64_t) ((totals.tx_bytes + totals.rx_bytes)
+                                            / totals.packets)
+                               : 0;
+        break;
+    case RID_COLLECTION_PERIOD:
+        out_value->int_value = get_ctx()->collection_period;
+        break;
+    default:
+        return ANJ_DM_ERR_NOT_FOUND;
+    }
+    return 0;
+}
+
+static int res_write(anj_t *anj,
+                     const anj_dm_obj_t *obj,
+                     anj_iid_t iid,
+                     anj_rid_t rid,
+                     anj_riid_t riid,
+                     const anj_res_value_t *value) {
+    (void) anj;
+    (void) obj;
+    (void) iid;
+    (void) riid;
+
+    switch (rid) {
+    case RID_COLLECTION_PERIOD:
+        if (value->int_value < 0 || value->int_value > UINT32_MAX / 1000) {
+            return ANJ_DM_ERR_BAD_REQUEST;
+        }
+        get_ctx()->collection_period = value->int_value;
+        break;
+    default:
+        return ANJ_DM_ERR_NOT_FOUND;
+    }
+    return 0;
+}
+
+static int res_execute(anj_t *anj,
+                       const anj_dm_obj_t *obj,
+                       anj_iid_t iid,
+                       anj_rid_t rid,
+                       const char *execute_arg,
+                       size_t execute_arg_len) {
+    (void) obj;
+    (void) iid;
+    (void) execute_arg;
+    (void) execute_arg_len;
+
+    switch (rid) {
+    case RID_START:
+        // restarting an ongoing collection resets the counters as well
+        start_collection(anj);
+        break;
+    case RID_STOP:
+        stop_collection(anj);
+        break;
+    default:
+        return ANJ_DM_ERR_NOT_FOUND;
+    }
+    return 0;
+}
+
+static int transaction_begin(anj_t *anj, const anj_dm_obj_t *obj) {
+    (void) anj;
+    (void) obj;
+    conn_stats_ctx_t *ctx = get_ctx();
+    ctx->collection_period_cached = ctx->collection_period;
+    return 0;
+}
+
+static void transaction_end(anj_t *anj,
+                            const anj_dm_obj_t *obj,
+                            anj_dm_transaction_result_t result) {
+    (void) anj;
+    (void) obj;
+    conn_stats_ctx_t *ctx = get_ctx();
+    if (result) {
+        // Restore cached data
+        ctx->collection_period = ctx->collection_period_cached;
+    }
+}
+
+static const anj_dm_handlers_t CONN_STATS_OBJ_HANDLERS = {
+    .res_read = res_read,
+    .res_write = res_write,
+    .res_execute = res_execute,
+    .transaction_begin = transaction_begin,
+    .transaction_end = transaction_end,
+};
+
+static const anj_dm_obj_inst_t INST = {
+    .iid = 0,
+    .res_count = CONN_STATS_RESOURCES_COUNT,
+    .resources = RES
+};
+
+static const anj_dm_obj_t OBJ = {
+    .oid = CONN_STATS_OID,
+    .version = "1.0",
+    .insts = &INST,
+    .handlers = &CONN_STATS_OBJ_HANDLERS,
+    .max_inst_count = 1
+};
+
+const anj_dm_obj_t *conn_stats_obj_init(void) {
+    memset(&conn_stats_ctx, 0, sizeof(conn_stats_ctx));
+    return &OBJ;
+}
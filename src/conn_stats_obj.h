@@ -0,0 +1,30 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#ifndef _CONN_STATS_OBJ_H_
+#define _CONN_STATS_OBJ_H_
+
+#include <anj/core.h>
+#include <anj/defs.h>
+
+/**
+ * @brief Returns the Connectivity Statistics Object (/7), backed by the
+ * counters of the network compat layer. Collection is stopped until the
+ * server executes the Start resource.
+ */
+const anj_dm_obj_t *conn_stats_obj_init(void);
+
+/**
+ * @brief Stops the collection once the Collection Period has elapsed.
+ *
+ * @param anj Anjay Lite instance the object is installed in.
+ */
+void conn_stats_obj_update(anj_t *anj);
+
+#endif // _CONN_STATS_OBJ_H_
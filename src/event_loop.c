@@ -0,0 +1,152 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <anj/log.h>
+
+#include <stm32u3xx_hal.h>
+
+#include "compat/net_stats.h"
+#include "power.h"
+#include "profiler.h"
+#include "timebase.h"
+
+#include "event_loop.h"
+
+#define loop_log(...) anj_log(loop, __VA_ARGS__)
+
+#define EVENT_LOOP_REPORT_PERIOD_US (60 * 1000 * 1000ULL)
+
+static event_loop_stats_t stats;
+// stats at the beginning of the current report period
+static event_loop_stats_t reported_stats;
+static power_stats_t reported_power_stats;
+static uint64_t report_start_us;
+
+static bool change_pending;
+static uint64_t change_us;
+static uint32_t last_tx_packets;
+
+void event_loop_init(void) {
+    // NOTE: with SEVONPEND, every interrupt that becomes pending sets the event
+    // register, even if it's handled right away. WFE returns immediately if
+    // the register is set, so an interrupt that arrived after the caller
+    // decided to sleep, but before WFE, does not delay the next iteration.
+    SET_BIT(SCB->SCR, SCB_SCR_SEVONPEND_Msk);
+    report_start_us = timebase_now_us();
+}
+
+void event_loop_wait(uint64_t deadline_us) {
+    uint64_t now = timebase_now_us();
+    if (deadline_us <= now) {
+        stats.busy_iterations++;
+        return;
+    }
+    timebase_set_wakeup(deadline_us);
+    power_sleep(deadline_us);
+    stats.wakeups++;
+    stats.sleep_us += timebase_now_us() - now;
+}
+
+void event_loop_data_changed(void) {
+    if (!change_pending) {
+        change_pending = true;
+        change_us = timebase_now_us();
+    }
+}
+
+static uint32_t tx_packets(void) {
+    return net_stats(NET_STATS_UDP)->tx.packets
+           + net_stats(NET_STATS_TCP)->tx.packets;
+}
+
+static void update_latency(void) {
+    uint32_t packets = tx_packets();
+    // NOTE: the counters go back to 0 when reset through the Connectivity
+    // Statistics object
+    bool sent = packets > last_tx_packets;
+    last_tx_packets = packets;
+    if (!sent || !change_pending) {
+        return;
+    }
+    change_pending = false;
+    uint64_t latency_us = timebase_now_us() - change_us;
+    stats.notify_latency_count++;
+    stats.notify_latency_sum_us += latency_us;
+    if (latency_us > stats.notify_latency_max_us) {
+        stats.notify_latency_max_us =
+                latency_us > UINT32_MAX ? UINT32_MAX : (uint32_t) latency_us;
+    }
+}
+
+static void report(uint64_t now) {
+    uint64_t period_us = now - report_start_us;
+    uint32_t wakeups = stats.wakeups - reported_stats.wakeups;
+    uint32_t busy = stats.busy_iterations - reported_stats.busy_iterations;
+    uint64_t sleep_us = stats.sleep_us - reported_stats.sleep_us;
+    uint32_t latency_count =
+            stats.notify_latency_count - reported_stats.notify_latency_count;
+    uint64_t latency_sum_us =
+            stats.notify_latency_sum_us - reported_stats.notify_latency_sum_us;
+
+    loop_log(L_INFO,
+             "%" PRIu32 ".%02" PRIu32 " wakeups/s, %" PRIu32
+             " busy iterations, %" PRIu32 "%% asleep",
+             (uint32_t) (wakeups * 1000000ULL / period_us),
+             (uint32_t) (wakeups * 100000000ULL / period_us % 100), busy,
+             (uint32_t) (sleep_us * 100 / period_us));
+    if (latency_count) {
+        loop_log(L_INFO,
+                 "notify latency: avg %" PRIu32 " us, max %" PRIu32
+                 " us, %" PRIu32 " samples",
+                 (uint32_t) (latency_sum_us / latency_count),
+                 stats.notify_latency_max_us, latency_count);
+    }
+
+    const power_stats_t *power = power_stats();
+    uint64_t run_us = power->residency_us[POWER_STATE_RUN]
+                      - reported_power_stats.residency_us[POWER_STATE_RUN];
+    uint64_t sleep_state_us =
+            power->residency_us[POWER_STATE_SLEEP]
+            - reported_power_stats.residency_us[POWER_STATE_SLEEP];
+    uint64_t stop2_us = power->residency_us[POWER_STATE_STOP2]
+                        - reported_power_stats.residency_us[POWER_STATE_STOP2];
+    loop_log(L_INFO,
+             "residency: run %" PRIu32 "%%, sleep %" PRIu32 "%%, stop2 %" PRIu32
+             "%% (%" PRIu32 " entries), clock restore max %" PRIu32 " us",
+             (uint32_t) (run_us * 100 / period_us),
+             (uint32_t) (sleep_state_us * 100 / period_us),
+             (uint32_t) (stop2_us * 100 / period_us),
+             power->entries[POWER_STATE_STOP2]
+                     - reported_power_stats.entries[POWER_STATE_STOP2],
+             power->max_restore_us);
+
+#ifdef CONFIG_PROFILER
+    profiler_log();
+#endif // CONFIG_PROFILER
+
+    reported_stats = stats;
+    reported_power_stats = *power;
+    report_start_us = now;
+}
+
+void event_loop_update(void) {
+    update_latency();
+    uint64_t now = timebase_now_us();
+    if (now - report_start_us >= EVENT_LOOP_REPORT_PERIOD_US) {
+        report(now);
+    }
+}
+
+const event_loop_stats_t *event_loop_stats(void) {
+    return &stats;
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#ifndef EVENT_LOOP_H
+#define EVENT_LOOP_H
+
+#include <stdint.h>
+
+typedef struct {
+    // number of times the loop went to sleep and was woken up
+    uint32_t wakeups;
+    // number of iterations that did not sleep, because work was already due
+    uint32_t busy_iterations;
+    uint64_t sleep_us;
+    // time from a data model change to the next datagram sent, which is the
+    // notification in the common case
+    uint32_t notify_latency_count;
+    uint64_t notify_latency_sum_us;
+    uint32_t notify_latency_max_us;
+} event_loop_stats_t;
+
+/**
+ * Configures the CPU so that @ref event_loop_wait never misses an interrupt
+ * that arrived before going to sleep.
+ */
+void event_loop_init(void);
+
+/**
+ * Sleeps until @p deadline_us or until any interrupt, e.g. modem UART RX or
+ * the user button, whichever comes first. Stop 2 is used when possible, see
+ * @ref power_sleep. Returns immediately if the deadline has already passed, or
+ * if an interrupt has been handled since the previous call, so that events
+ * that arrived while the caller was computing the deadline are not slept
+ * through.
+ *
+ * @param deadline_us Absolute time, as returned by @ref timebase_now_us.
+ */
+void event_loop_wait(uint64_t deadline_us);
+
+/**
+ * Marks the beginning of a notification latency measurement, i.e. a value
+ * change that is expected to be notified. Ignored if a measurement is already
+ * in progress.
+ */
+void event_loop_data_changed(void);
+
+/**
+ * Completes the latency measurement once a datagram has been sent, and logs
+ * the loop and power state statistics once a minute.
+ */
+void event_loop_update(void);
+
+const event_loop_stats_t *event_loop_stats(void);
+
+#endif // EVENT_LOOP_H
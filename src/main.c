@@ -17,6 +17,8 @@
 #include <anj/dm/security_object.h>
 #include <anj/dm/server_object.h>
 #include <anj/log.h>
+#include <anj/time.h>
+#include <anj/utils.h>
 
 #include <mbedtls/memory_buffer_alloc.h>
 
@@ -30,11 +32,28 @@
 #include <usart.h>
 
 #include "modem/modem.h"
+#include "modem/modem_radio.h"
 
-#include "temperature_obj.h"
+#include "conn_mon_obj.h"
+#include "conn_stats_obj.h"
+#include "event_loop.h"
+#include "power.h"
+#include "profiler.h"
+#include "profiler_obj.h"
+#include "sensor_obj.h"
+#include "timebase.h"
 
 #define app_log(...) anj_log(app, __VA_ARGS__)
 
+// Upper bound of a single sleep, for the code that is only serviced from the
+// loop and has no deadline of its own: modem command timeouts, the radio
+// poller and the connectivity objects. lwIP timers run as often as TCP needs.
+#ifdef CONFIG_NET_PPP
+#    define LOOP_MAX_SLEEP_US (250 * 1000ULL)
+#else // CONFIG_NET_PPP
+#    define LOOP_MAX_SLEEP_US (1000 * 1000ULL)
+#endif // CONFIG_NET_PPP
+
 static int install_security_obj(anj_t *anj,
                                 anj_dm_security_obj_t *security_obj) {
     anj_dm_security_instance_init_t security_inst = {
@@ -63,7 +82,7 @@ static int install_security_obj(anj_t *anj,
 static int install_server_obj(anj_t *anj, anj_dm_server_obj_t *server_obj) {
     anj_dm_server_instance_init_t server_inst = {
         .ssid = 1,
-        .lifetime = 50,
+        .lifetime = CONFIG_LIFETIME,
         .binding = "U",
         .bootstrap_on_registration_failure = &(bool) { false },
     };
@@ -82,17 +101,33 @@ static int install_device_obj(anj_t *anj, anj_dm_device_obj_t *device_obj) {
     return anj_dm_device_obj_install(anj, device_obj, &device_obj_conf);
 }
 
+static uint64_t next_deadline(anj_t *anj, uint64_t sensor_deadline_us) {
+    uint64_t now = timebase_now_us();
+    uint64_t deadline = ANJ_MIN(now + LOOP_MAX_SLEEP_US, sensor_deadline_us);
+    anj_time_duration_t anj_wait = anj_core_next_step_time(anj);
+    if (anj_time_duration_is_valid(anj_wait)) {
+        int64_t anj_wait_us =
+                anj_time_duration_to_scalar(anj_wait, ANJ_TIME_UNIT_US);
+        deadline = ANJ_MIN(now + (uint64_t) ANJ_MAX(anj_wait_us, 0), deadline);
+    }
+    return deadline;
+}
+
 // Default size mentioned in MbedTLS docs is 100KB
 static uint8_t mbedtls_static_memory[100 * 1024];
 
 int main(void) {
     HAL_Init();
     SystemClock_Config();
+#ifdef CONFIG_PROFILER
+    profiler_init();
+#endif // CONFIG_PROFILER
     MX_GPIO_Init();
     MX_GPDMA1_Init();
     MX_ADC1_Init();
     MX_LPUART1_UART_Init();
     MX_RNG_Init();
+    power_init();
 
     /* Init BSP */
     BSP_LED_Init(LED_GREEN);
@@ -155,17 +190,48 @@ int main(void) {
             return -1;
         }
 
-        if (anj_dm_add_obj(&anj, temperature_sensor_init())) {
-            app_log(L_ERROR, "Failed to install temperature object error");
+        if (sensor_obj_install(&anj)) {
+            app_log(L_ERROR, "Failed to install sensor objects");
+            return -1;
+        }
+
+        if (anj_dm_add_obj(&anj, conn_mon_obj_init())) {
+            app_log(L_ERROR,
+                    "Failed to install connectivity monitoring object");
             return -1;
         }
+
+        if (anj_dm_add_obj(&anj, conn_stats_obj_init())) {
+            app_log(L_ERROR,
+                    "Failed to install connectivity statistics object");
+            return -1;
+        }
+
+#ifdef CONFIG_PROFILER
+        if (anj_dm_add_obj(&anj, profiler_obj_init())) {
+            app_log(L_ERROR, "Failed to install profiler object");
+            return -1;
+        }
+#endif // CONFIG_PROFILER
     }
     app_log(L_INFO, "Anjay Lite initialized");
 
+    event_loop_init();
     while (1) {
+        PROFILER_BEGIN(ANJ_CORE_STEP);
         anj_core_step(&anj);
-        HAL_Delay(10);
+        PROFILER_END(ANJ_CORE_STEP);
+        event_loop_update();
         check_button_state();
-        temperature_sensor_update(&anj);
+        if (sensor_obj_update(&anj)) {
+            event_loop_data_changed();
+        }
+        conn_stats_obj_update(&anj);
+        modem_radio_poll();
+        conn_mon_obj_update(&anj);
+        // NOTE: sleeps until the next deadline, or until UART RX, the user
+        // button or any other interrupt; a value changed above makes Anjay
+        // Lite request the next step immediately, so there is no sleep then
+        event_loop_wait(next_deadline(&anj, sensor_obj_deadline_us()));
     }
 }
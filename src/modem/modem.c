@@ -10,6 +10,7 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 #include <anj/log.h>
 #include <anj/utils.h>
@@ -20,69 +21,28 @@
 #include "modem.h"
 #include "modem_constants.h"
 #include "modem_rx.h"
+#include "modem_sleep.h"
 #include "modem_tx.h"
 
 #include "circ_buf.h"
+#include "profiler.h"
 
 #define modem_log(...) anj_log(modem, __VA_ARGS__)
 
+#define QUOTE(Value) #Value
+#define QUOTE_MACRO(Value) QUOTE(Value)
+
 // Note: we rely on this using utils from Anjay Lite
 ANJ_STATIC_ASSERT(sizeof(size_t) == sizeof(uint32_t), size_t_is_4_bytes);
 
 // Implementation limitations (besides the ones described in net.c):
-// - no other URCs besides +QIURC: "recv" are handled; other URCs that might be
-//   worth handling:
-//   - "closed" - in case the remote end (in TCP) closes the connection
+// - no other URCs besides +QIURC: "recv" and "closed" are handled; other URCs
+//   that might be worth handling:
 //   - "pdpdeact" - in case the PDP context is deactivated
 // - there's no detection of other spurious messages that might be sent by the
 //   modem, e.g. when the connection with the network is lost
 // - no support for HW flow control; this might be helpful in case we'd like to
 //   avoid extensive buffering in our driver
-// - no protection whatsoever against calling different methods for different
-//   sockets in case some "stateful" operation is in progress, e.g. asynchronous
-//   handling of AT+QIOPEN requires multiple calls
-// - no timeout handling for any of the methods
-
-static bool line_starts_with(const char *str, size_t line_len) {
-    size_t i = 0;
-    while (str[i] != '\0' && i < line_len) {
-        if (modem_rx_seek(i) != str[i]) {
-            return false;
-        }
-        i++;
-    }
-    return str[i] == '\0';
-}
-
-static bool line_equals(const char *str, size_t line_len) {
-    for (size_t i = 0; i < line_len; i++) {
-        if (str[i] == '\0' || modem_rx_seek(i) != str[i]) {
-            return false;
-        }
-    }
-
-    return str[line_len] == '\0';
-}
-
-// NOTE: implemented as macro to correctly report the line number
-#define warn_and_advance(Len)                                                 \
-    do {                                                                      \
-        size_t To_seek = ANJ_MIN(Len, 64);                                    \
-        char Buf[64 + 1];                                                     \
-        size_t I = 0;                                                         \
-        for (; I < To_seek; I++) {                                            \
-            Buf[I] = modem_rx_seek(I);                                        \
-        }                                                                     \
-        Buf[I] = '\0';                                                        \
-        if (Len > 64) {                                                       \
-            modem_log(L_WARNING, "skipping RX (len: %u): %s...",              \
-                      (unsigned) Len, Buf);                                   \
-        } else {                                                              \
-            modem_log(L_WARNING, "skipping RX (len: %u): %s", (unsigned) Len, \
-                      Buf);                                                   \
-        }                                                                     \
-        modem_rx_advance(Len);                                                \
-    } while (0)
 
 #define RECV_QIURC_LENS_BUF_SIZE 15
 static volatile uint8_t recv_qiurc_buf_storage[MODEM_SOCKET_RECV_MAX + 1];
@@ -96,29 +56,49 @@ static size_t recv_qiurc_lens_start = 0;
 static size_t recv_qiurc_lens_end = 0;
 static size_t recv_qiurc_lens_count = 0;
 
-static int urc_buffer_handler(void) {
+static const char recv_urc_header[] = "+QIURC: \"recv\",0,";
+static const char closed_urc[] = "+QIURC: \"closed\",0";
+
+static modem_socket_type_t socket_type;
+static bool socket_peer_closed;
+// set once a part of the TCP stream has been dropped; whatever comes after it
+// is useless, so the socket is reported as failed instead
+static bool socket_stream_broken;
+static modem_socket_stats_t socket_stats;
+
+static void count_dropped(size_t msg_len) {
+    socket_stats.rx_dropped++;
+    socket_stats.rx_dropped_bytes += (uint32_t) msg_len;
+}
+// unacknowledged bytes reported by the last AT+QISEND=0,0 query, plus bytes
+// sent since then; TCP only
+static size_t tcp_unacked_estimate;
+
+static bool recv_queue_has_space(size_t msg_len) {
+    return msg_len <= circ_buf_free(&recv_qiurc_buf)
+           && recv_qiurc_lens_count < RECV_QIURC_LENS_BUF_SIZE;
+}
+
+// marks the last msg_len bytes pushed to recv_qiurc_buf as a single message
+static void recv_queue_commit(size_t msg_len) {
+    recv_qiurc_lens[recv_qiurc_lens_end] = msg_len;
+    recv_qiurc_lens_end = (recv_qiurc_lens_end + 1) % RECV_QIURC_LENS_BUF_SIZE;
+    recv_qiurc_lens_count++;
+}
+
+static int process_recv_urc(size_t line_len) {
     // incoming lines are in form:
     // +QIURC: "recv",0,<n>\r\n
     // <raw n bytes>
 
     // NOTE: this method may be called in case the whole payload has not been
     // written to the RX buffer yet, so do not consume the buffer eagerly.
-    size_t line_len;
-    if (modem_rx_seek_line_length(&line_len)) {
-        return 1;
-    }
-
-    static const char header[] = "+QIURC: \"recv\",0,";
-    static const char header_len = sizeof(header) - 1;
-    if (!line_starts_with(header, line_len)) {
-        warn_and_advance(line_len);
-        return 1;
-    }
+    static const size_t header_len = sizeof(recv_urc_header) - 1;
 
     char msg_len_str[4]; // 1500 bytes max: assume 4 digits (no nullterm needed)
     size_t msg_len_str_len = line_len - header_len;
     if (msg_len_str_len > sizeof(msg_len_str)) {
-        warn_and_advance(line_len);
+        modem_rx_warn_and_advance(line_len);
         return -1;
     }
     for (size_t i = 0; i < msg_len_str_len; i++) {
@@ -128,7 +108,7 @@ static int urc_buffer_handler(void) {
     size_t msg_len;
     if (anj_string_to_uint32_value((uint32_t *) &msg_len, msg_len_str,
                                    msg_len_str_len)) {
-        warn_and_advance(line_len);
+        modem_rx_warn_and_advance(line_len);
         return -1;
     }
 
@@ -143,22 +123,28 @@ static int urc_buffer_handler(void) {
     // consuming the RX buffer
     modem_rx_advance(line_len + 2);
 
-    if (msg_len > circ_buf_free(&recv_qiurc_buf)
-            || recv_qiurc_lens_count >= RECV_QIURC_LENS_BUF_SIZE) {
+    if (socket_type == MODEM_SOCKET_TCP && socket_stream_broken) {
+        modem_rx_advance(msg_len);
+        count_dropped(msg_len);
+        return -1;
+    }
+
+    if (!recv_queue_has_space(msg_len)) {
         modem_log(L_WARNING,
                   "Dropping recv urc because the buffer is too short");
-        warn_and_advance(msg_len);
+        modem_rx_warn_and_advance(msg_len);
+        count_dropped(msg_len);
+        socket_stream_broken = socket_type == MODEM_SOCKET_TCP;
         return -1;
     }
 
-    // NOTE: change this when adding support for TCP
-    bool is_udp = true;
-    if (is_udp && msg_len == MODEM_SOCKET_RECV_MAX) {
+    if (socket_type == MODEM_SOCKET_UDP && msg_len == MODEM_SOCKET_RECV_MAX) {
         // BG96 TCP/IP AT Commands Manual states that up to 1500 bytes can be
         // received, but we don't know whether messages above that, in case of
         // UDP, are dropped, or truncated. Assume that they could be truncated,
         // so let's drop them.
-        warn_and_advance(msg_len);
+        modem_rx_warn_and_advance(msg_len);
+        count_dropped(msg_len);
         return -1;
     }
 
@@ -166,16 +152,66 @@ static int urc_buffer_handler(void) {
     for (size_t i = 0; i < msg_len; i++) {
         circ_buf_push(&recv_qiurc_buf, modem_rx_pop());
     }
-    recv_qiurc_lens[recv_qiurc_lens_end] = msg_len;
-    recv_qiurc_lens_end = (recv_qiurc_lens_end + 1) % RECV_QIURC_LENS_BUF_SIZE;
-    recv_qiurc_lens_count++;
+    recv_queue_commit(msg_len);
 
     return 0;
 }
 
+static int urc_buffer_handler(size_t line_len) {
+    PROFILER_BEGIN(URC_BUFFER_HANDLER);
+    int result = process_recv_urc(line_len);
+    PROFILER_END(URC_BUFFER_HANDLER);
+    return result;
+}
+
+static int closed_urc_handler(size_t line_len) {
+    if (!modem_rx_line_equals(closed_urc, line_len)) {
+        modem_rx_warn_and_advance(line_len);
+        return -1;
+    }
+    modem_rx_advance(line_len);
+    modem_log(L_DEBUG, "socket closed by the remote end");
+    socket_peer_closed = true;
+    return 0;
+}
+
+// TCP data has no message boundaries, so a read may span multiple URCs and
+// leave a part of the last one for the next read
+static size_t stream_recv(uint8_t *buf, size_t buf_len) {
+    size_t copied = 0;
+    while (copied < buf_len && recv_qiurc_lens_count) {
+        size_t *chunk_len = &recv_qiurc_lens[recv_qiurc_lens_start];
+        size_t to_copy = ANJ_MIN(*chunk_len, buf_len - copied);
+        for (size_t i = 0; i < to_copy; i++) {
+            buf[copied++] = circ_buf_pop(&recv_qiurc_buf);
+        }
+        *chunk_len -= to_copy;
+        if (!*chunk_len) {
+            recv_qiurc_lens_start =
+                    (recv_qiurc_lens_start + 1) % RECV_QIURC_LENS_BUF_SIZE;
+            recv_qiurc_lens_count--;
+        }
+    }
+    return copied;
+}
+
 int modem_socket_try_recv(uint8_t *buf, size_t buf_len, size_t *out_msg_len) {
+    modem_queue_process();
     if (recv_qiurc_lens_count == 0) {
-        return urc_buffer_handler() < 0 ? -1 : 1;
+        if (socket_type == MODEM_SOCKET_TCP && socket_stream_broken) {
+            // everything received before the loss has been read
+            return -1;
+        }
+        if (socket_type == MODEM_SOCKET_TCP && socket_peer_closed) {
+            // end of stream
+            *out_msg_len = 0;
+            return 0;
+        }
+        return 1;
+    }
+    if (socket_type == MODEM_SOCKET_TCP) {
+        *out_msg_len = stream_recv(buf, buf_len);
+        return 0;
     }
 
     size_t msg_len = recv_qiurc_lens[recv_qiurc_lens_start];
@@ -197,40 +233,19 @@ int modem_socket_try_recv(uint8_t *buf, size_t buf_len, size_t *out_msg_len) {
     return 0;
 }
 
-typedef struct {
-    const char *response;
-    int return_code;
-} response_t;
-
-static const response_t ok_or_error[] = { { "OK", 0 }, { "ERROR", -1 } };
-
-static int match_responses(const response_t *responses,
-                           size_t responses_len,
-                           int on_unexpected) {
-    size_t line_len;
-    if (modem_rx_seek_line_length(&line_len)) {
-        return 1;
-    }
-    for (size_t i = 0; i < responses_len; i++) {
-        if (line_equals(responses[i].response, line_len)) {
-            modem_rx_advance(line_len);
-            return responses[i].return_code;
-        }
-    }
-
-    warn_and_advance(line_len);
-    return on_unexpected;
+bool modem_socket_closed(void) {
+    modem_queue_process();
+    return socket_peer_closed;
 }
 
-static int match_responses_strict(const response_t *responses,
-                                  size_t responses_len) {
-    return match_responses(responses, responses_len, -1);
+const modem_socket_stats_t *modem_socket_stats(void) {
+    return &socket_stats;
 }
 
-static int match_responses_lenient(const response_t *responses,
-                                   size_t responses_len) {
-    return match_responses(responses, responses_len, 1);
-}
+static const modem_response_t ok_or_error[] = {
+    { "OK", 0, false },
+    { "ERROR", -1, false }
+};
 
 int modem_send_command(const char *command) {
     int res;
@@ -243,52 +258,156 @@ int modem_send_command(const char *command) {
     return modem_tx_start();
 }
 
+static void op_finished(modem_cmd_t *cmd, int result) {
+    modem_op_t *op = (modem_op_t *) cmd->arg;
+    op->finished = true;
+    op->result = result;
+}
+
+static int op_submit(modem_op_t *op,
+                     const char *const *parts,
+                     size_t parts_count,
+                     const modem_response_t *responses,
+                     size_t responses_count,
+                     uint32_t timeout_ms,
+                     modem_cmd_prio_t prio,
+                     modem_channel_t channel) {
+    op->cmd = (modem_cmd_t) {
+        .responses = responses,
+        .responses_count = responses_count,
+        .timeout_ms = timeout_ms,
+        .prio = prio,
+        .channel = channel,
+        .finished_handler = op_finished,
+        .arg = op
+    };
+    op->finished = false;
+    op->result = 0;
+    if (modem_cmd_set_command(&op->cmd, parts, parts_count)) {
+        return -1;
+    }
+    return modem_queue_submit(&op->cmd);
+}
+
+static int op_continue(modem_op_t *op) {
+    modem_queue_process();
+    return op->finished ? op->result : 1;
+}
+
+void modem_op_cancel(modem_op_t *op) {
+    modem_queue_cancel(&op->cmd);
+    op->finished = true;
+    op->result = -1;
+}
+
 // NOTE: we observed that when connection times out application
 // fails to properly close and reopen socket, it might be worth to
 // debug this implementation (some issues might also be related to modem rx
 // buffer handling)
 int modem_socket_open_init(modem_socket_open_ctx_t *ctx,
+                           modem_socket_type_t type,
                            const char *hostname,
-                           const char *port) {
-    // sanity flush of the buffer to clear out trash that might
-    // cause issues in future
-    modem_rx_buf_flush();
-    const char *to_write[] = { "AT+QIOPEN=1,0,\"UDP\",\"", hostname, "\",",
-                               port, ",0,1\r\n" };
-    for (size_t i = 0; i < ANJ_ARRAY_SIZE(to_write); i++) {
-        if (modem_tx_append_str(to_write[i])) {
-            return -1;
-        }
-    }
-    if (modem_tx_start()) {
-        return -1;
-    }
-    ctx->step = 0;
-    return 0;
+                           const char *port,
+                           uint16_t local_port) {
+    static const modem_response_t responses[] = {
+        { "OK", 1, false },
+        { "ERROR", -1, false },
+        { "+QIOPEN: 0,0", 0, false },
+        { "+QIOPEN: 0,", -1, true },
+    };
+    // NOTE: BG96 accepts an explicit local port for "UDP" client sockets as
+    // well, so there's no need to fall back to "UDP SERVICE" sockets, which
+    // would require passing the remote address with every AT+QISEND
+    char local_port_buf[6];
+    local_port_buf[anj_uint32_to_string_value(local_port_buf, local_port)] =
+            '\0';
+    const char *command[] = { "AT+QIOPEN=1,0,\"",
+                              type == MODEM_SOCKET_TCP ? "TCP" : "UDP",
+                              "\",\"",
+                              hostname,
+                              "\",",
+                              port,
+                              ",",
+                              local_port_buf,
+                              ",1" };
+    socket_type = type;
+    socket_peer_closed = false;
+    socket_stream_broken = false;
+    tcp_unacked_estimate = 0;
+    return op_submit(ctx, command, ANJ_ARRAY_SIZE(command), responses,
+                     ANJ_ARRAY_SIZE(responses), MODEM_QIOPEN_TIMEOUT_MS,
+                     MODEM_CMD_PRIO_NORMAL, MODEM_CHANNEL_DATA);
 }
 
 int modem_socket_open_continue(modem_socket_open_ctx_t *ctx) {
-    switch (ctx->step) {
-    case 0: {
-        int res = match_responses_strict(ok_or_error,
-                                         ANJ_ARRAY_SIZE(ok_or_error));
-        if (res) {
-            return res;
+    return op_continue(ctx);
+}
+
+static uint16_t queried_local_port;
+
+static void qistate_line_handler(modem_cmd_t *cmd,
+                                 const char *line,
+                                 size_t line_len) {
+    (void) cmd;
+    (void) line_len;
+    // +QISTATE: <connectID>,"<service_type>","<IP_address>",<remote_port>,
+    //           <local_port>,<socket_state>,...
+    const char *field = line;
+    for (size_t i = 0; i < 4 && field; i++) {
+        field = strchr(field, ',');
+        if (field) {
+            field++;
         }
-        ctx->step = 1;
-        return 1;
     }
-    case 1: {
-        static const response_t responses[] = {
-            { "+QIOPEN: 0,0", 0 },
-        };
-        return match_responses_strict(responses, ANJ_ARRAY_SIZE(responses));
+    const char *field_end = field ? strchr(field, ',') : NULL;
+    uint32_t value;
+    if (field_end
+            && !anj_string_to_uint32_value(&value, field,
+                                           (size_t) (field_end - field))
+            && value <= UINT16_MAX) {
+        queried_local_port = (uint16_t) value;
     }
-    default: { return -1; }
+}
+
+int modem_socket_local_port_init(modem_socket_state_ctx_t *ctx) {
+    static const modem_response_t responses[] = {
+        { "+QISTATE: 0,", 1, true },
+        { "OK", 0, false },
+        { "ERROR", -1, false }
+    };
+    const char *command[] = { "AT+QISTATE=1,0" };
+    queried_local_port = 0;
+    int res = op_submit(ctx, command, ANJ_ARRAY_SIZE(command), responses,
+                        ANJ_ARRAY_SIZE(responses), 1000, MODEM_CMD_PRIO_NORMAL,
+                        MODEM_CHANNEL_DATA);
+    ctx->cmd.line_handler = qistate_line_handler;
+    return res;
+}
+
+int modem_socket_local_port_continue(modem_socket_state_ctx_t *ctx,
+                                     uint16_t *out_port) {
+    int res = op_continue(ctx);
+    if (res) {
+        return res;
     }
+    if (!queried_local_port) {
+        return -1;
+    }
+    *out_port = queried_local_port;
+    return 0;
 }
 
-int modem_socket_send_init(modem_socket_send_ctx_t *ctx, size_t len) {
+int modem_socket_send_init(modem_socket_send_ctx_t *ctx,
+                           const uint8_t *buf,
+                           size_t len) {
+    static const modem_response_t responses[] = {
+        { "SEND OK", 0, false },
+        { "SEND FAIL", -1, false },
+        { "ERROR", -1, false },
+        // For some reason BG96 might send a space character after the
+        // prompt, so let's handle it here...
+        { " ", 1, false }
+    };
     if (len > MODEM_SOCKET_SEND_MAX) {
         // modem cannot send messages longer than 1460 bytes in one go
         return -1;
@@ -297,82 +416,146 @@ int modem_socket_send_init(modem_socket_send_ctx_t *ctx, size_t len) {
     char len_buf[6];
     len_buf[anj_uint32_to_string_value(len_buf, len)] = '\0';
 
-    const char *to_write[] = { "AT+QISEND=0,", len_buf, "\r\n" };
+    const char *command[] = { "AT+QISEND=0,", len_buf };
+    int res = op_submit(ctx, command, ANJ_ARRAY_SIZE(command), responses,
+                        ANJ_ARRAY_SIZE(responses), MODEM_QISEND_TIMEOUT_MS,
+                        MODEM_CMD_PRIO_HIGH, MODEM_CHANNEL_DATA);
+    ctx->cmd.payload = buf;
+    ctx->cmd.payload_len = len;
+    return res;
+}
+
+int modem_socket_send_continue(modem_socket_send_ctx_t *ctx) {
+    return op_continue(ctx);
+}
+
+static void unacked_line_handler(modem_cmd_t *cmd,
+                                 const char *line,
+                                 size_t line_len) {
+    (void) cmd;
+    // +QISEND: <total_send_length>,<ackedbytes>,<unackedbytes>
+    const char *unacked = strrchr(line, ',');
+    if (!unacked) {
+        return;
+    }
+    unacked++;
+    uint32_t value;
+    if (!anj_string_to_uint32_value(&value, unacked,
+                                    line_len - (size_t) (unacked - line))) {
+        tcp_unacked_estimate = value;
+    }
+}
+
+static int stream_send_query(modem_socket_stream_send_ctx_t *ctx) {
+    static const modem_response_t responses[] = {
+        { "+QISEND: ", 1, true },
+        { "OK", 0, false },
+        { "ERROR", -1, false }
+    };
+    const char *command[] = { "AT+QISEND=0,0" };
+    int res = op_submit(&ctx->query, command, ANJ_ARRAY_SIZE(command),
+                        responses, ANJ_ARRAY_SIZE(responses),
+                        MODEM_QISEND_TIMEOUT_MS, MODEM_CMD_PRIO_HIGH,
+                        MODEM_CHANNEL_DATA);
+    ctx->query.cmd.line_handler = unacked_line_handler;
+    ctx->querying = !res;
+    return res;
+}
 
-    for (size_t i = 0; i < ANJ_ARRAY_SIZE(to_write); i++) {
-        if (modem_tx_append_str(to_write[i])) {
+static int stream_send_submit(modem_socket_stream_send_ctx_t *ctx) {
+    // all chunks are queued at once, so they're sent back-to-back without
+    // waiting for the caller to poll in between
+    size_t offset = 0;
+    for (ctx->chunks_count = 0;
+         ctx->chunks_count < MODEM_TCP_SEND_PIPELINE && offset < ctx->len;
+         ctx->chunks_count++) {
+        size_t chunk_len = ANJ_MIN(ctx->len - offset, MODEM_SOCKET_SEND_MAX);
+        if (modem_socket_send_init(&ctx->chunks[ctx->chunks_count],
+                                   ctx->buf + offset, chunk_len)) {
+            modem_socket_stream_send_cancel(ctx);
             return -1;
         }
+        offset += chunk_len;
     }
+    ctx->submitted = offset;
+    tcp_unacked_estimate += offset;
+    return 0;
+}
 
-    if (modem_tx_start()) {
-        return -1;
+int modem_socket_stream_send_init(modem_socket_stream_send_ctx_t *ctx,
+                                  const uint8_t *buf,
+                                  size_t len) {
+    *ctx = (modem_socket_stream_send_ctx_t) {
+        .buf = buf,
+        .len = ANJ_MIN(len, MODEM_TCP_SEND_PIPELINE * MODEM_SOCKET_SEND_MAX)
+    };
+    if (tcp_unacked_estimate + ctx->len > MODEM_TCP_UNACKED_MAX) {
+        // the estimate only grows between queries, check the actual value
+        return stream_send_query(ctx);
     }
-    ctx->step = 0;
-    return 0;
+    return stream_send_submit(ctx);
 }
 
-int modem_socket_send_continue(modem_socket_send_ctx_t *ctx,
-                               size_t len,
-                               const uint8_t *buf) {
-    switch (ctx->step) {
-    case 0: {
-        bool emptied = modem_rx_pop_newlines();
-        if (emptied) {
+int modem_socket_stream_send_continue(modem_socket_stream_send_ctx_t *ctx,
+                                      size_t *out_sent) {
+    modem_queue_process();
+    if (ctx->querying) {
+        if (!ctx->query.finished) {
             return 1;
         }
-        char prompt = modem_rx_seek(0);
-        if (prompt != '>') {
-            modem_log(L_WARNING, "unexpected character instead of prompt: 0x%x",
-                      (unsigned) prompt);
-
-            return urc_buffer_handler() < 0 ? -1 : 1;
+        if (ctx->query.result < 0) {
+            return -1;
         }
-        modem_rx_advance(1); // skip the prompt
-
-        // transmit data
-        int res;
-        if ((res = modem_tx_append(buf, len))) {
-            return res;
+        ctx->querying = false;
+        ctx->last_query_tick = HAL_GetTick();
+    }
+    if (!ctx->chunks_count) {
+        if (tcp_unacked_estimate + ctx->len <= MODEM_TCP_UNACKED_MAX) {
+            return stream_send_submit(ctx) ? -1 : 1;
         }
-        // append Ctrl-Z to signal end of transmission
-        if ((res = modem_tx_append(&(const uint8_t) { 0x1A }, 1))) {
-            return res;
+        // peer is not keeping up, poll until it acknowledges enough data
+        if (HAL_GetTick() - ctx->last_query_tick
+                >= MODEM_TCP_UNACKED_POLL_MS) {
+            return stream_send_query(ctx) ? -1 : 1;
         }
-        ctx->step = 1;
-        return modem_tx_start() ? -1 : 1;
-    }
-    case 1: {
-        static const response_t responses[] = {
-            { "SEND OK", 0 },
-            // For some reason BG96 might send a space character after the
-            // prompt, so let's handle it here...
-            { " ", 1 }
-        };
-        return match_responses_strict(responses, ANJ_ARRAY_SIZE(responses));
+        return 1;
     }
-    default: { return -1; }
+    for (size_t i = 0; i < ctx->chunks_count; i++) {
+        if (!ctx->chunks[i].finished) {
+            return 1;
+        }
+        if (ctx->chunks[i].result < 0) {
+            modem_socket_stream_send_cancel(ctx);
+            return -1;
+        }
     }
+    *out_sent = ctx->submitted;
+    return 0;
 }
 
-// NOTE: we observed that when connection times out application
-// fails to properly close and reopen socket, it might be worth to
-// debug this implementation (some issues might also be related to modem rx
-// buffer handling)
-int modem_socket_close_init(void) {
-    // sanity flush of the buffer to clear out trash that might
-    // cause issues in future
-    modem_rx_buf_flush();
+void modem_socket_stream_send_cancel(modem_socket_stream_send_ctx_t *ctx) {
+    if (ctx->querying) {
+        modem_op_cancel(&ctx->query);
+        ctx->querying = false;
+    }
+    for (size_t i = 0; i < ctx->chunks_count; i++) {
+        modem_op_cancel(&ctx->chunks[i]);
+    }
+}
 
-    return modem_send_command("AT+QICLOSE=0");
+int modem_socket_close_init(modem_socket_close_ctx_t *ctx) {
+    const char *command[] = { "AT+QICLOSE=0" };
+    return op_submit(ctx, command, ANJ_ARRAY_SIZE(command), ok_or_error,
+                     ANJ_ARRAY_SIZE(ok_or_error), MODEM_QICLOSE_TIMEOUT_MS,
+                     MODEM_CMD_PRIO_NORMAL, MODEM_CHANNEL_DATA);
 }
 
-int modem_socket_close_continue(void) {
-    return match_responses_strict(ok_or_error, ANJ_ARRAY_SIZE(ok_or_error));
+int modem_socket_close_continue(modem_socket_close_ctx_t *ctx) {
+    return op_continue(ctx);
 }
 
 static int bringup_command_ex(const char *command,
-                              const response_t *responses,
+                              const modem_response_t *responses,
                               size_t responses_count,
                               uint32_t timeout_ms,
                               size_t attempts,
@@ -385,22 +568,24 @@ static int bringup_command_ex(const char *command,
         if (i > 0) {
             HAL_Delay(delay_ms);
         }
-        if (modem_send_command(command)) {
+        modem_op_t op;
+        if (op_submit(&op, &command, 1, responses, responses_count,
+                      timeout_ms, MODEM_CMD_PRIO_NORMAL,
+                      MODEM_CHANNEL_CONTROL)) {
             modem_log(L_ERROR, "failed to send command: %s", command);
             return -1;
         }
-        uint32_t deadline = HAL_GetTick() + timeout_ms;
-        while (HAL_GetTick() < deadline) {
-            int res = match_responses_lenient(responses, responses_count);
-            if (res > 0) {
-                continue;
-            }
-            if (res < 0) {
-                modem_log(L_ERROR, "received an error response, code: %d", res);
-                return -1;
-            }
-            return 0;
+        int res;
+        while ((res = op_continue(&op)) > 0) {
         }
+        if (res == MODEM_CMD_ERR_TIMEOUT) {
+            continue;
+        }
+        if (res < 0) {
+            modem_log(L_ERROR, "received an error response, code: %d", res);
+            return -1;
+        }
+        return 0;
     }
     modem_log(L_ERROR, "bringup command timed out: %s", command);
     return -1;
@@ -411,14 +596,184 @@ static int bringup_command(const char *command) {
                               5000, 1, 0);
 }
 
+#ifdef CONFIG_NET_PPP
+// With CMUX, PPP runs on the data channel next to AT control
+static int ppp_dial(void) {
+    static const modem_response_t responses[] = {
+        { "CONNECT", 0, true },
+        { "NO CARRIER", -1, false },
+        { "ERROR", -1, false }
+    };
+    const char *command[] = { "ATD*99#" };
+    modem_op_t op;
+    modem_log(L_DEBUG, "dialing PPP data connection");
+    if (op_submit(&op, command, ANJ_ARRAY_SIZE(command), responses,
+                  ANJ_ARRAY_SIZE(responses), MODEM_PPP_DIAL_TIMEOUT_MS,
+                  MODEM_CMD_PRIO_NORMAL, MODEM_CHANNEL_DATA)) {
+        return -1;
+    }
+    int res;
+    while ((res = op_continue(&op)) > 0) {
+    }
+    if (res) {
+        modem_log(L_ERROR, "failed to enter PPP data mode");
+        return -1;
+    }
+    modem_queue_enter_data_mode(MODEM_CHANNEL_DATA);
+    return 0;
+}
+
+static circ_buf_t *data_mode_rx_buf(void) {
+    return modem_cmux_active() ? modem_cmux_channel_buf(MODEM_CHANNEL_DATA)
+                               : modem_rx_raw_buf();
+}
+
+size_t modem_data_mode_read(uint8_t *buf, size_t buf_len) {
+    circ_buf_t *rx_buf = data_mode_rx_buf();
+    size_t read = 0;
+    // NOTE: more frames are demultiplexed only once the data channel has been
+    // drained, so that a burst waits in the raw buffer instead of overflowing
+    // the channel; see modem_cmux_process()
+    while (read < buf_len) {
+        if (!circ_buf_avail(rx_buf)) {
+            // also keeps AT control working on other channels
+            modem_queue_process();
+            if (!circ_buf_avail(rx_buf)) {
+                break;
+            }
+        }
+        size_t to_read = ANJ_MIN(circ_buf_avail(rx_buf), buf_len - read);
+        for (size_t i = 0; i < to_read; i++) {
+            buf[read++] = circ_buf_pop(rx_buf);
+        }
+    }
+    return read;
+}
+
+int modem_data_mode_write(const uint8_t *buf, size_t len) {
+    if (modem_cmux_write(MODEM_CHANNEL_DATA, buf, len)) {
+        return -1;
+    }
+    return modem_tx_start();
+}
+#endif // CONFIG_NET_PPP
+
+#ifdef CONFIG_NET_NIDD
+static const char crtdcp_urc_header[] = "+CRTDCP: ";
+
+// hex-encoded payload followed by the closing quote of the AT+CSODCP command
+static uint8_t nidd_tx_hex[2 * MODEM_NIDD_DATA_MAX + 1];
+
+static int hex_value(char chr) {
+    if (chr >= '0' && chr <= '9') {
+        return chr - '0';
+    }
+    if (chr >= 'A' && chr <= 'F') {
+        return chr - 'A' + 10;
+    }
+    if (chr >= 'a' && chr <= 'f') {
+        return chr - 'a' + 10;
+    }
+    return -1;
+}
+
+static int crtdcp_urc_handler(size_t line_len) {
+    // incoming lines are in form:
+    // +CRTDCP: <cid>,<cpdata_length>,"<cpdata>"
+    // where <cpdata> is hex-encoded
+    char header[sizeof(crtdcp_urc_header) + 16];
+    modem_rx_copy(header, sizeof(header), line_len);
+    const char *len_str = strchr(header, ',');
+    const char *len_end = len_str ? strchr(++len_str, ',') : NULL;
+    uint32_t msg_len;
+    if (!len_end || len_end[1] != '"'
+            || anj_string_to_uint32_value(&msg_len, len_str,
+                                          (size_t) (len_end - len_str))) {
+        modem_rx_warn_and_advance(line_len);
+        return -1;
+    }
+    size_t data_offset = (size_t) (len_end - header) + 2;
+    if (data_offset + 2 * msg_len + 1 != line_len) {
+        modem_rx_warn_and_advance(line_len);
+        return -1;
+    }
+    if (!recv_queue_has_space(msg_len)) {
+        modem_log(L_WARNING, "Dropping NIDD data because the buffer is too "
+                             "short");
+        modem_rx_advance(line_len);
+        count_dropped(msg_len);
+        return -1;
+    }
+
+    // validate before consuming anything, so that no partial message is
+    // pushed to the receive queue
+    for (size_t i = 0; i < 2 * msg_len; i++) {
+        if (hex_value(modem_rx_seek(data_offset + i)) < 0) {
+            modem_rx_warn_and_advance(line_len);
+            return -1;
+        }
+    }
+    modem_rx_advance(data_offset);
+    for (size_t i = 0; i < msg_len; i++) {
+        int high = hex_value(modem_rx_pop());
+        int low = hex_value(modem_rx_pop());
+        circ_buf_push(&recv_qiurc_buf, (uint8_t) (high << 4 | low));
+    }
+    modem_rx_advance(1); // closing quote
+    recv_queue_commit(msg_len);
+    return 0;
+}
+
+int modem_nidd_send_init(modem_nidd_send_ctx_t *ctx,
+                         const uint8_t *buf,
+                         size_t len) {
+    static const char hex_digits[] = "0123456789ABCDEF";
+    if (len > MODEM_NIDD_DATA_MAX) {
+        return -1;
+    }
+    for (size_t i = 0; i < len; i++) {
+        nidd_tx_hex[2 * i] = (uint8_t) hex_digits[buf[i] >> 4];
+        nidd_tx_hex[2 * i + 1] = (uint8_t) hex_digits[buf[i] & 0x0F];
+    }
+    nidd_tx_hex[2 * len] = '"';
+
+    char len_buf[6];
+    len_buf[anj_uint32_to_string_value(len_buf, len)] = '\0';
+    // RAI is not requested, as the server may respond
+    const char *command[] = { "AT+CSODCP=1,", len_buf, ",\"" };
+    int res = op_submit(ctx, command, ANJ_ARRAY_SIZE(command), ok_or_error,
+                        ANJ_ARRAY_SIZE(ok_or_error), MODEM_CSODCP_TIMEOUT_MS,
+                        MODEM_CMD_PRIO_HIGH, MODEM_CHANNEL_DATA);
+    ctx->cmd.payload = nidd_tx_hex;
+    ctx->cmd.payload_len = 2 * len + 1;
+    ctx->cmd.payload_inline = true;
+    return res;
+}
+
+int modem_nidd_send_continue(modem_nidd_send_ctx_t *ctx) {
+    return op_continue(ctx);
+}
+#endif // CONFIG_NET_NIDD
+
 #ifndef CONFIG_APN
 #    define CONFIG_APN "internet"
 #endif // CONFIG_APN
 
 int modem_bringup(void) {
-    if (modem_rx_start()) {
+    modem_sleep_init();
+    if (modem_rx_start()
+            || modem_queue_register_urc_handler(recv_urc_header,
+                                                urc_buffer_handler)
+            || modem_queue_register_urc_handler(closed_urc,
+                                                closed_urc_handler)) {
         return -1;
     }
+#ifdef CONFIG_NET_NIDD
+    if (modem_queue_register_urc_handler(crtdcp_urc_header,
+                                         crtdcp_urc_handler)) {
+        return -1;
+    }
+#endif // CONFIG_NET_NIDD
 
     // test if modem is responding at all; this also might help with autobaud
     if (bringup_command_ex("AT", ok_or_error, ANJ_ARRAY_SIZE(ok_or_error), 1000,
@@ -438,28 +793,54 @@ int modem_bringup(void) {
         return -1;
     }
     // configure APN
+#ifdef CONFIG_NET_NIDD
+    if (bringup_command_ex("AT+CGDCONT=1,\"Non-IP\",\"" CONFIG_APN "\"",
+                           ok_or_error, ANJ_ARRAY_SIZE(ok_or_error), 10000, 1,
+                           0)) {
+        return -1;
+    }
+#else  // CONFIG_NET_NIDD
     if (bringup_command_ex("AT+CGDCONT=1,\"IP\",\"" CONFIG_APN "\"",
                            ok_or_error, ANJ_ARRAY_SIZE(ok_or_error), 10000, 1,
                            0)) { //
         return -1;
     }
+#endif // CONFIG_NET_NIDD
     // enable full functionality
     if (bringup_command("AT+CFUN=1")) {
         return -1;
     }
-    // activate PDP context
+#if defined(CONFIG_NET_NIDD)
+    // activate the Non-IP PDN connection and enable reporting of incoming data
+    if (bringup_command_ex("AT+CGACT=1,1", ok_or_error,
+                           ANJ_ARRAY_SIZE(ok_or_error), 20000, 1, 0)
+            || bringup_command("AT+CRTDCP=1")) {
+        return -1;
+    }
+#elif !defined(CONFIG_NET_PPP)
+    // activate PDP context; in PPP mode it is activated by dialing instead
     if (bringup_command_ex("AT+QIACT=1", ok_or_error,
                            ANJ_ARRAY_SIZE(ok_or_error), 20000, 1, 0)) {
         return -1;
     }
+#endif // CONFIG_NET_NIDD
     // disable network registration URCs
     if (bringup_command("AT+CREG=0")) {
         return -1;
     }
-    // disable sleep mode
+#ifdef MODEM_SLEEP_WITH_DTR
+    // enable sleep mode; the modem only sleeps while DTR is high, i.e. after
+    // modem_sleep_enter()
+    if (bringup_command("AT+QSCLK=1")) {
+        return -1;
+    }
+    modem_sleep_allow();
+#else  // MODEM_SLEEP_WITH_DTR
+    // disable sleep mode, as there's no way to wake the modem up without DTR
     if (bringup_command("AT+QSCLK=0")) {
         return -1;
     }
+#endif // MODEM_SLEEP_WITH_DTR
     // disable PSM
     if (bringup_command("AT+CPSMS=0")) {
         return -1;
@@ -472,23 +853,38 @@ int modem_bringup(void) {
     if (bringup_command("AT+QURCCFG=\"urcport\",\"uart1\"")) {
         return -1;
     }
-    static const response_t creg_responses[] = {
-        { "+CREG: 0,1", 0 }, // registered, home network
-        { "+CREG: 0,5", 0 }, // registered, roaming,
-        { "OK", 1 }, // if for some reason OK is returned early, do not treat it
-                     // as success
-        { "ERROR", -1 }, // error shall cause return early
+    static const modem_response_t creg_responses[] = {
+        { "+CREG: 0,1", 0, false }, // registered, home network
+        { "+CREG: 0,5", 0, false }, // registered, roaming,
+        { "OK", 1, false }, // if for some reason OK is returned early, do not
+                            // treat it as success
+        { "ERROR", -1, false }, // error shall cause return early
     };
     // wait for modem to report proper network registration status
     if (bringup_command_ex("AT+CREG?", creg_responses,
                            ANJ_ARRAY_SIZE(creg_responses), 1000, 5, 1000)) {
         return -1;
     }
+#if !defined(CONFIG_NET_PPP) && !defined(CONFIG_NET_NIDD)
     // log PDP context status
     if (bringup_command("AT+QIACT?")) {
         return -1;
     }
+#endif // !defined(CONFIG_NET_PPP) && !defined(CONFIG_NET_NIDD)
     HAL_Delay(200);
     modem_rx_buf_flush();
+#ifdef CONFIG_MODEM_CMUX
+    // switch to multiplexed mode; this has to be the last bringup step, as the
+    // raw stream must not be flushed afterwards
+    if (bringup_command("AT+CMUX=0,0,5," QUOTE_MACRO(MODEM_CMUX_N1))
+            || modem_cmux_start()) {
+        return -1;
+    }
+#endif // CONFIG_MODEM_CMUX
+#ifdef CONFIG_NET_PPP
+    if (ppp_dial()) {
+        return -1;
+    }
+#endif // CONFIG_NET_PPP
     return 0;
 }
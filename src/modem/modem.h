@@ -14,30 +14,150 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "modem_constants.h"
+#include "modem_queue.h"
+
+/**
+ * Asynchronous socket operation, backed by a single command queue entry.
+ */
+typedef struct {
+    modem_cmd_t cmd;
+    bool finished;
+    int result;
+} modem_op_t;
+
+typedef modem_op_t modem_socket_open_ctx_t;
+typedef modem_op_t modem_socket_send_ctx_t;
+typedef modem_op_t modem_socket_close_ctx_t;
+typedef modem_op_t modem_socket_state_ctx_t;
+typedef modem_op_t modem_nidd_send_ctx_t;
+
+/**
+ * TCP send split into chunks of at most @ref MODEM_SOCKET_SEND_MAX bytes,
+ * queued back-to-back.
+ */
 typedef struct {
-    int step;
-} modem_socket_open_ctx_t;
+    modem_op_t chunks[MODEM_TCP_SEND_PIPELINE];
+    size_t chunks_count;
+    modem_op_t query;
+    bool querying;
+    uint32_t last_query_tick;
+    const uint8_t *buf;
+    size_t len;
+    size_t submitted;
+} modem_socket_stream_send_ctx_t;
+
+typedef enum {
+    MODEM_SOCKET_UDP,
+    MODEM_SOCKET_TCP
+} modem_socket_type_t;
 
 typedef struct {
-    int step;
-} modem_socket_send_ctx_t;
+    // incoming messages discarded by the modem layer, e.g. because the
+    // receive queue was full; these never reach the net layer
+    uint32_t rx_dropped;
+    uint32_t rx_dropped_bytes;
+} modem_socket_stats_t;
 
 int modem_bringup(void);
 int modem_send_command(const char *command);
 
+void modem_op_cancel(modem_op_t *op);
+
+/**
+ * @param local_port Local port to bind to, 0 to let the modem choose one.
+ */
 int modem_socket_open_init(modem_socket_open_ctx_t *ctx,
+                           modem_socket_type_t type,
                            const char *hostname,
-                           const char *port);
+                           const char *port,
+                           uint16_t local_port);
 int modem_socket_open_continue(modem_socket_open_ctx_t *ctx);
 
+/**
+ * Queries the local port of the open socket using AT+QISTATE.
+ */
+int modem_socket_local_port_init(modem_socket_state_ctx_t *ctx);
+int modem_socket_local_port_continue(modem_socket_state_ctx_t *ctx,
+                                     uint16_t *out_port);
+
+/**
+ * For UDP sockets, receives a single datagram. For TCP sockets, receives up to
+ * @p buf_len bytes of the stream; @p out_msg_len is set to 0 once the remote
+ * end has closed the connection and all data has been received. If a part of
+ * the stream had to be dropped because the receive queue was full, an error is
+ * returned once the data preceding it has been received.
+ *
+ * @returns 0 on success, 1 if there's no data available yet, or a negative
+ *          value in case of an error.
+ */
 int modem_socket_try_recv(uint8_t *buf, size_t buf_len, size_t *out_msg_len);
 
-int modem_socket_send_init(modem_socket_send_ctx_t *ctx, size_t len);
-int modem_socket_send_continue(modem_socket_send_ctx_t *ctx,
-                               size_t len,
-                               const uint8_t *buf);
+/**
+ * Returns true if the modem has reported the socket closed, with a +QIURC:
+ * "closed" URC, since it was opened. For a UDP socket, this means that it is
+ * gone on the modem side, e.g. after the network has dropped the connection.
+ */
+bool modem_socket_closed(void);
+
+const modem_socket_stats_t *modem_socket_stats(void);
 
-int modem_socket_close_init(void);
-int modem_socket_close_continue(void);
+// NOTE: @p buf must stay valid until the operation is finished
+int modem_socket_send_init(modem_socket_send_ctx_t *ctx,
+                           const uint8_t *buf,
+                           size_t len);
+int modem_socket_send_continue(modem_socket_send_ctx_t *ctx);
+
+/**
+ * Starts sending up to @ref MODEM_TCP_SEND_PIPELINE chunks of @p buf over a TCP
+ * socket. If more than @ref MODEM_TCP_UNACKED_MAX bytes would be left
+ * unacknowledged by the peer, sending is held back until it catches up.
+ *
+ * NOTE: @p buf must stay valid until the operation is finished
+ */
+int modem_socket_stream_send_init(modem_socket_stream_send_ctx_t *ctx,
+                                  const uint8_t *buf,
+                                  size_t len);
+/**
+ * @returns 0 once finished, with @p out_sent set to the number of bytes sent,
+ *          which may be less than requested, 1 if still in progress, or
+ *          a negative value in case of an error.
+ */
+int modem_socket_stream_send_continue(modem_socket_stream_send_ctx_t *ctx,
+                                      size_t *out_sent);
+void modem_socket_stream_send_cancel(modem_socket_stream_send_ctx_t *ctx);
+
+int modem_socket_close_init(modem_socket_close_ctx_t *ctx);
+int modem_socket_close_continue(modem_socket_close_ctx_t *ctx);
+
+#ifdef CONFIG_NET_PPP
+/**
+ * Reads raw data received in PPP data mode; established by
+ * @ref modem_bringup when PPP is enabled.
+ *
+ * @returns Number of bytes read.
+ */
+size_t modem_data_mode_read(uint8_t *buf, size_t buf_len);
+
+/**
+ * Queues raw data for transmission in PPP data mode.
+ *
+ * @returns 0 on success, -1 if there's not enough space in the TX buffer.
+ */
+int modem_data_mode_write(const uint8_t *buf, size_t len);
+#endif // CONFIG_NET_PPP
+
+#ifdef CONFIG_NET_NIDD
+/**
+ * Sends a datagram over the Non-IP PDN connection using AT+CSODCP. Incoming
+ * data (+CRTDCP URCs) is received with @ref modem_socket_try_recv.
+ *
+ * NOTE: @p buf may be released once this function returns
+ */
+int modem_nidd_send_init(modem_nidd_send_ctx_t *ctx,
+                         const uint8_t *buf,
+                         size_t len);
+int modem_nidd_send_continue(modem_nidd_send_ctx_t *ctx);
+#endif // CONFIG_NET_NIDD
 
 #endif // MODEM_ASYNC_H
@@ -0,0 +1,346 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <anj/log.h>
+#include <anj/utils.h>
+
+#include <stm32u3xx_hal.h>
+
+#include "circ_buf.h"
+#include "modem_cmux.h"
+#include "modem_constants.h"
+#include "modem_rx.h"
+#include "modem_tx.h"
+
+#ifdef CONFIG_MODEM_CMUX
+
+#    define modem_log(...) anj_log(modem, __VA_ARGS__)
+
+// Basic option framing per 3GPP TS 27.010:
+// | flag | address | control | length (1-2 B) | info | FCS | flag |
+#    define CMUX_FLAG 0xF9
+#    define CMUX_EA 0x01
+#    define CMUX_CR 0x02
+#    define CMUX_PF 0x10
+
+#    define CMUX_SABM 0x2F
+#    define CMUX_UA 0x63
+#    define CMUX_DM 0x0F
+#    define CMUX_DISC 0x43
+#    define CMUX_UIH 0xEF
+
+// FCS computed over the header and the received FCS yields this constant
+#    define CMUX_FCS_GOOD 0xCF
+
+#    define CMUX_DLCI_CONTROL 0
+#    define CMUX_DLCI_COUNT (_MODEM_CHANNEL_COUNT + 1)
+#    define CMUX_OPEN_TIMEOUT_MS 1000
+
+// flag, address, control, length and FCS, flag
+#    define CMUX_FRAME_OVERHEAD 6
+
+// Reversed CRC-8, polynomial x^8 + x^2 + x + 1 (0xE0), per TS 27.010
+static const uint8_t fcs_table[256] = {
+    0x00, 0x91, 0xE3, 0x72, 0x07, 0x96, 0xE4, 0x75,
+    0x0E, 0x9F, 0xED, 0x7C, 0x09, 0x98, 0xEA, 0x7B,
+    0x1C, 0x8D, 0xFF, 0x6E, 0x1B, 0x8A, 0xF8, 0x69,
+    0x12, 0x83, 0xF1, 0x60, 0x15, 0x84, 0xF6, 0x67,
+    0x38, 0xA9, 0xDB, 0x4A, 0x3F, 0xAE, 0xDC, 0x4D,
+    0x36, 0xA7, 0xD5, 0x44, 0x31, 0xA0, 0xD2, 0x43,
+    0x24, 0xB5, 0xC7, 0x56, 0x23, 0xB2, 0xC0, 0x51,
+    0x2A, 0xBB, 0xC9, 0x58, 0x2D, 0xBC, 0xCE, 0x5F,
+    0x70, 0xE1, 0x93, 0x02, 0x77, 0xE6, 0x94, 0x05,
+    0x7E, 0xEF, 0x9D, 0x0C, 0x79, 0xE8, 0x9A, 0x0B,
+    0x6C, 0xFD, 0x8F, 0x1E, 0x6B, 0xFA, 0x88, 0x19,
+    0x62, 0xF3, 0x81, 0x10, 0x65, 0xF4, 0x86, 0x17,
+    0x48, 0xD9, 0xAB, 0x3A, 0x4F, 0xDE, 0xAC, 0x3D,
+    0x46, 0xD7, 0xA5, 0x34, 0x41, 0xD0, 0xA2, 0x33,
+    0x54, 0xC5, 0xB7, 0x26, 0x53, 0xC2, 0xB0, 0x21,
+    0x5A, 0xCB, 0xB9, 0x28, 0x5D, 0xCC, 0xBE, 0x2F,
+    0xE0, 0x71, 0x03, 0x92, 0xE7, 0x76, 0x04, 0x95,
+    0xEE, 0x7F, 0x0D, 0x9C, 0xE9, 0x78, 0x0A, 0x9B,
+    0xFC, 0x6D, 0x1F, 0x8E, 0xFB, 0x6A, 0x18, 0x89,
+    0xF2, 0x63, 0x11, 0x80, 0xF5, 0x64, 0x16, 0x87,
+    0xD8, 0x49, 0x3B, 0xAA, 0xDF, 0x4E, 0x3C, 0xAD,
+    0xD6, 0x47, 0x35, 0xA4, 0xD1, 0x40, 0x32, 0xA3,
+    0xC4, 0x55, 0x27, 0xB6, 0xC3, 0x52, 0x20, 0xB1,
+    0xCA, 0x5B, 0x29, 0xB8, 0xCD, 0x5C, 0x2E, 0xBF,
+    0x90, 0x01, 0x73, 0xE2, 0x97, 0x06, 0x74, 0xE5,
+    0x9E, 0x0F, 0x7D, 0xEC, 0x99, 0x08, 0x7A, 0xEB,
+    0x8C, 0x1D, 0x6F, 0xFE, 0x8B, 0x1A, 0x68, 0xF9,
+    0x82, 0x13, 0x61, 0xF0, 0x85, 0x14, 0x66, 0xF7,
+    0xA8, 0x39, 0x4B, 0xDA, 0xAF, 0x3E, 0x4C, 0xDD,
+    0xA6, 0x37, 0x45, 0xD4, 0xA1, 0x30, 0x42, 0xD3,
+    0xB4, 0x25, 0x57, 0xC6, 0xB3, 0x22, 0x50, 0xC1,
+    0xBA, 0x2B, 0x59, 0xC8, 0xBD, 0x2C, 0x5E, 0xCF,
+};
+
+static inline uint8_t fcs_update(uint8_t fcs, uint8_t byte) {
+    return fcs_table[fcs ^ byte];
+}
+
+typedef enum {
+    RX_STATE_FLAG,
+    RX_STATE_ADDRESS,
+    RX_STATE_CONTROL,
+    RX_STATE_LENGTH,
+    RX_STATE_LENGTH_2,
+    RX_STATE_INFO,
+    RX_STATE_FCS,
+    // a frame is decoded, but its channel has no room for it yet
+    RX_STATE_PENDING
+} rx_state_t;
+
+typedef struct {
+    rx_state_t state;
+    uint8_t dlci;
+    uint8_t control;
+    uint8_t fcs;
+    size_t len;
+    size_t pos;
+    uint8_t info[MODEM_CMUX_N1];
+} rx_frame_t;
+
+static bool active;
+static bool dlc_open[CMUX_DLCI_COUNT];
+static rx_frame_t rx_frame;
+
+// NOTE: the modem reports URCs, including +QIURC: "recv" with its payload, on
+// any channel, so each of them has to hold as much as the raw RX buffer
+static volatile uint8_t control_buf_storage[MODEM_RX_BUF];
+static volatile uint8_t data_buf_storage[MODEM_RX_BUF];
+static volatile uint8_t urc_buf_storage[MODEM_RX_BUF];
+
+static circ_buf_t channel_bufs[_MODEM_CHANNEL_COUNT] = {
+    [MODEM_CHANNEL_CONTROL] = {
+        .len = sizeof(control_buf_storage),
+        .storage = control_buf_storage
+    },
+    [MODEM_CHANNEL_DATA] = {
+        .len = sizeof(data_buf_storage),
+        .storage = data_buf_storage
+    },
+    [MODEM_CHANNEL_URC] = {
+        .len = sizeof(urc_buf_storage),
+        .storage = urc_buf_storage
+    }
+};
+
+static int send_frame(uint8_t dlci,
+                      uint8_t control,
+                      const uint8_t *info,
+                      size_t len) {
+    assert(len <= MODEM_CMUX_N1);
+    uint8_t header[4] = {
+        CMUX_FLAG, (uint8_t) ((dlci << 2) | CMUX_CR | CMUX_EA), control,
+        (uint8_t) ((len << 1) | CMUX_EA)
+    };
+    uint8_t fcs = 0xFF;
+    for (size_t i = 1; i < sizeof(header); i++) {
+        fcs = fcs_update(fcs, header[i]);
+    }
+    uint8_t trailer[2] = { (uint8_t) (0xFF - fcs), CMUX_FLAG };
+
+    if (modem_tx_buf_free() < len + CMUX_FRAME_OVERHEAD) {
+        return -1;
+    }
+    modem_tx_append(header, sizeof(header));
+    modem_tx_append(info, len);
+    modem_tx_append(trailer, sizeof(trailer));
+    return 0;
+}
+
+/**
+ * @returns false if the frame has to wait until its channel has room for it.
+ */
+static bool handle_frame(void) {
+    uint8_t dlci = rx_frame.dlci;
+    if (dlci >= CMUX_DLCI_COUNT) {
+        modem_log(L_WARNING, "CMUX frame for unknown DLCI %u", (unsigned) dlci);
+        return true;
+    }
+    switch (rx_frame.control) {
+    case CMUX_UA: {
+        dlc_open[dlci] = true;
+        break;
+    }
+    case CMUX_DM: {
+        modem_log(L_WARNING, "CMUX DLCI %u rejected", (unsigned) dlci);
+        dlc_open[dlci] = false;
+        break;
+    }
+    case CMUX_UIH: {
+        if (dlci == CMUX_DLCI_CONTROL) {
+            // multiplexer control messages, e.g. MSC; nothing to do with them
+            modem_log(L_TRACE, "ignoring CMUX control message");
+            break;
+        }
+        if (circ_buf_append(&channel_bufs[dlci - 1], rx_frame.info,
+                            rx_frame.len)) {
+            return false;
+        }
+        break;
+    }
+    default: {
+        modem_log(L_TRACE, "ignoring CMUX frame, control 0x%x",
+                  (unsigned) rx_frame.control);
+        break;
+    }
+    }
+    return true;
+}
+
+void modem_cmux_process(void) {
+    if (!active) {
+        return;
+    }
+    if (rx_frame.state == RX_STATE_PENDING) {
+        if (!handle_frame()) {
+            return;
+        }
+        rx_frame.state = RX_STATE_FLAG;
+    }
+    // NOTE: decoding stops at a frame that doesn't fit in its channel, the
+    // rest stays in the raw buffer until the channel is read from
+    circ_buf_t *raw = modem_rx_raw_buf();
+    while (rx_frame.state != RX_STATE_PENDING && circ_buf_avail(raw) > 0) {
+        uint8_t byte = circ_buf_pop(raw);
+        switch (rx_frame.state) {
+        case RX_STATE_FLAG: {
+            if (byte == CMUX_FLAG) {
+                rx_frame.state = RX_STATE_ADDRESS;
+            }
+            break;
+        }
+        case RX_STATE_ADDRESS: {
+            if (byte == CMUX_FLAG) {
+                // closing flag of the previous frame or inter-frame fill
+                break;
+            }
+            rx_frame.fcs = fcs_update(0xFF, byte);
+            rx_frame.dlci = (uint8_t) (byte >> 2);
+            rx_frame.state = RX_STATE_CONTROL;
+            break;
+        }
+        case RX_STATE_CONTROL: {
+            rx_frame.fcs = fcs_update(rx_frame.fcs, byte);
+            rx_frame.control = (uint8_t) (byte & ~CMUX_PF);
+            rx_frame.state = RX_STATE_LENGTH;
+            break;
+        }
+        case RX_STATE_LENGTH:
+        case RX_STATE_LENGTH_2: {
+            rx_frame.fcs = fcs_update(rx_frame.fcs, byte);
+            if (rx_frame.state == RX_STATE_LENGTH) {
+                rx_frame.len = byte >> 1;
+            } else {
+                rx_frame.len |= (size_t) byte << 7;
+            }
+            if (rx_frame.state == RX_STATE_LENGTH && !(byte & CMUX_EA)) {
+                rx_frame.state = RX_STATE_LENGTH_2;
+                break;
+            }
+            if (rx_frame.len > sizeof(rx_frame.info)) {
+                modem_log(L_WARNING, "CMUX frame too long, resynchronizing");
+                rx_frame.state = RX_STATE_FLAG;
+                break;
+            }
+            rx_frame.pos = 0;
+            rx_frame.state = rx_frame.len ? RX_STATE_INFO : RX_STATE_FCS;
+            break;
+        }
+        case RX_STATE_INFO: {
+            rx_frame.info[rx_frame.pos++] = byte;
+            if (rx_frame.pos == rx_frame.len) {
+                rx_frame.state = RX_STATE_FCS;
+            }
+            break;
+        }
+        case RX_STATE_FCS: {
+            // NOTE: in basic option, FCS of UIH frames covers the header only;
+            // other frame types used here carry no information field
+            rx_frame.state = RX_STATE_FLAG;
+            if (fcs_update(rx_frame.fcs, byte) != CMUX_FCS_GOOD) {
+                modem_log(L_WARNING, "CMUX FCS mismatch, dropping frame");
+            } else if (!handle_frame()) {
+                rx_frame.state = RX_STATE_PENDING;
+            }
+            break;
+        }
+        case RX_STATE_PENDING: {
+            // not reached, the loop stops at a pending frame
+            break;
+        }
+        }
+    }
+}
+
+static int open_dlc(uint8_t dlci) {
+    dlc_open[dlci] = false;
+    if (send_frame(dlci, CMUX_SABM | CMUX_PF, NULL, 0) || modem_tx_start()) {
+        return -1;
+    }
+    uint32_t start = HAL_GetTick();
+    while (!dlc_open[dlci]) {
+        if (HAL_GetTick() - start >= CMUX_OPEN_TIMEOUT_MS) {
+            modem_log(L_ERROR, "CMUX DLCI %u open timed out", (unsigned) dlci);
+            return -1;
+        }
+        modem_cmux_process();
+    }
+    return 0;
+}
+
+int modem_cmux_start(void) {
+    active = true;
+    rx_frame.state = RX_STATE_FLAG;
+    for (size_t i = 0; i < _MODEM_CHANNEL_COUNT; i++) {
+        circ_buf_flush(&channel_bufs[i]);
+    }
+    for (uint8_t dlci = 0; dlci < CMUX_DLCI_COUNT; dlci++) {
+        if (open_dlc(dlci)) {
+            active = false;
+            return -1;
+        }
+    }
+    modem_log(L_INFO, "CMUX started, %u channels open",
+              (unsigned) _MODEM_CHANNEL_COUNT);
+    return 0;
+}
+
+bool modem_cmux_active(void) {
+    return active;
+}
+
+circ_buf_t *modem_cmux_channel_buf(modem_channel_t channel) {
+    return &channel_bufs[channel];
+}
+
+int modem_cmux_write(modem_channel_t channel, const uint8_t *buf, size_t len) {
+    if (!active) {
+        return modem_tx_append(buf, len);
+    }
+    size_t frames = (len + MODEM_CMUX_N1 - 1) / MODEM_CMUX_N1;
+    if (modem_tx_buf_free() < len + frames * CMUX_FRAME_OVERHEAD) {
+        return -1;
+    }
+    uint8_t dlci = (uint8_t) (channel + 1);
+    for (size_t offset = 0; offset < len; offset += MODEM_CMUX_N1) {
+        send_frame(dlci, CMUX_UIH, &buf[offset],
+                   ANJ_MIN(len - offset, MODEM_CMUX_N1));
+    }
+    return 0;
+}
+
+#endif // CONFIG_MODEM_CMUX
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#ifndef MODEM_CMUX_H
+#define MODEM_CMUX_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "circ_buf.h"
+#include "modem_tx.h"
+
+/**
+ * Logical channels of the modem link. With CMUX enabled, each of them is
+ * mapped to a separate DLC (DLCI = channel + 1), otherwise they all share the
+ * raw UART stream.
+ */
+typedef enum {
+    MODEM_CHANNEL_CONTROL, // AT control commands, bringup, diagnostics
+    MODEM_CHANNEL_DATA,    // socket operations
+    MODEM_CHANNEL_URC,     // unsolicited result codes
+    _MODEM_CHANNEL_COUNT
+} modem_channel_t;
+
+#ifdef CONFIG_MODEM_CMUX
+
+/**
+ * Opens the multiplexer control channel and all DLCs. Has to be called right
+ * after the modem accepted AT+CMUX. Blocks until all channels are open.
+ */
+int modem_cmux_start(void);
+
+bool modem_cmux_active(void);
+
+/**
+ * Decodes frames from the raw UART stream into per-channel buffers. Stops at
+ * a frame that doesn't fit in its channel buffer, which is then retried on
+ * the next call, so that a channel that isn't read from holds the raw stream
+ * back rather than losing data.
+ */
+void modem_cmux_process(void);
+
+circ_buf_t *modem_cmux_channel_buf(modem_channel_t channel);
+
+/**
+ * Appends @p buf to the TX buffer, wrapped into UIH frames if CMUX is active.
+ * Either all data is appended, or nothing.
+ */
+int modem_cmux_write(modem_channel_t channel, const uint8_t *buf, size_t len);
+
+#else // CONFIG_MODEM_CMUX
+
+static inline bool modem_cmux_active(void) {
+    return false;
+}
+
+static inline void modem_cmux_process(void) {}
+
+static inline circ_buf_t *modem_cmux_channel_buf(modem_channel_t channel) {
+    (void) channel;
+    return NULL;
+}
+
+static inline int
+modem_cmux_write(modem_channel_t channel, const uint8_t *buf, size_t len) {
+    (void) channel;
+    return modem_tx_append(buf, len);
+}
+
+#endif // CONFIG_MODEM_CMUX
+
+#endif // MODEM_CMUX_H
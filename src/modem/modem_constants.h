@@ -14,8 +14,41 @@
 #define MODEM_SOCKET_SEND_MAX 1460
 #define MODEM_SOCKET_RECV_MAX 1500
 
+// Maximum NIDD datagram size; matches the Anjay Lite message buffers
+#define MODEM_NIDD_DATA_MAX 1200
+
 // Assume that 256 bytes is enough for other other stuff like URC headers, etc.
-#define MODEM_RX_BUF (MODEM_SOCKET_RECV_MAX + 256)
+#ifdef CONFIG_NET_NIDD
+// NIDD data is received hex-encoded as a part of a single URC line, which has
+// to fit in the buffer as a whole
+#    define MODEM_RX_BUF (2 * MODEM_NIDD_DATA_MAX + 256)
+#else // CONFIG_NET_NIDD
+#    define MODEM_RX_BUF (MODEM_SOCKET_RECV_MAX + 256)
+#endif // CONFIG_NET_NIDD
 #define MODEM_TX_BUF (MODEM_SOCKET_SEND_MAX + 256)
 
+// Maximum information field length of CMUX frames, negotiated in AT+CMUX
+#define MODEM_CMUX_N1 127
+
+// Maximum response times per BG96 TCP/IP AT Commands Manual
+#define MODEM_QIOPEN_TIMEOUT_MS 150000
+#define MODEM_QICLOSE_TIMEOUT_MS 10000
+// "SEND OK" is reported once data is handed over to the protocol stack, which
+// is not specified explicitly, so allow some headroom
+#define MODEM_QISEND_TIMEOUT_MS 10000
+#define MODEM_PPP_DIAL_TIMEOUT_MS 30000
+#define MODEM_CSODCP_TIMEOUT_MS 10000
+
+// TCP flow control: at most this many chunks are queued per send, and sending
+// stops while the peer has not acknowledged this many bytes
+#define MODEM_TCP_SEND_PIPELINE 4
+#define MODEM_TCP_UNACKED_MAX \
+    (2 * MODEM_TCP_SEND_PIPELINE * MODEM_SOCKET_SEND_MAX)
+#define MODEM_TCP_UNACKED_POLL_MS 500
+
+// BG96 needs some time to restore the UART after DTR is pulled low; AT is
+// retried until it responds or MODEM_WAKE_TIMEOUT_MS elapses
+#define MODEM_WAKE_PROBE_TIMEOUT_MS 300
+#define MODEM_WAKE_TIMEOUT_MS 2000
+
 #endif // MODEM_CONSTANTS_H
@@ -0,0 +1,392 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <anj/log.h>
+#include <anj/utils.h>
+
+#include <stm32u3xx_hal.h>
+
+#include "modem_queue.h"
+#include "modem_rx.h"
+#include "modem_sleep.h"
+#include "modem_tx.h"
+
+#define modem_log(...) anj_log(modem, __VA_ARGS__)
+
+#define CTRL_Z 0x1A
+#define ESC 0x1B
+// inline payload is written in small pieces, so that CMUX framing overhead
+// always fits in MODEM_CMD_TX_RESERVE
+#define INLINE_PAYLOAD_CHUNK 64
+
+typedef struct {
+    const char *prefix;
+    modem_urc_handler_t *handler;
+} urc_entry_t;
+
+// Command currently in flight. It is tracked separately from the submitter's
+// storage, because a cancelled command still has to be waited for: otherwise
+// its late responses would be attributed to the next command.
+typedef struct {
+    modem_cmd_t *cmd; // NULL if cancelled
+    bool active;
+    modem_cmd_state_t state;
+    const modem_response_t *responses;
+    size_t responses_count;
+    uint32_t start_tick;
+    uint32_t timeout_ms;
+    size_t payload_offset;
+} in_flight_t;
+
+// one FIFO list per priority level
+static modem_cmd_t *queue_heads[_MODEM_CMD_PRIO_COUNT];
+// one slot per channel; only the first one is used if CMUX is not active
+static in_flight_t in_flight_slots[_MODEM_CHANNEL_COUNT];
+
+static size_t lanes_count(void) {
+    return modem_cmux_active() ? _MODEM_CHANNEL_COUNT : 1;
+}
+
+static in_flight_t *lane_of(const modem_cmd_t *cmd) {
+    return &in_flight_slots[modem_cmux_active() ? cmd->channel : 0];
+}
+
+// lanes with AT parsing disabled
+static bool data_mode[_MODEM_CHANNEL_COUNT];
+
+static urc_entry_t urc_handlers[MODEM_URC_HANDLERS_MAX];
+static size_t urc_handlers_count;
+
+int modem_cmd_set_command(modem_cmd_t *cmd,
+                          const char *const *parts,
+                          size_t parts_count) {
+    size_t offset = 0;
+    for (size_t i = 0; i < parts_count; i++) {
+        size_t len = strlen(parts[i]);
+        if (offset + len >= sizeof(cmd->command)) {
+            return -1;
+        }
+        memcpy(&cmd->command[offset], parts[i], len);
+        offset += len;
+    }
+    cmd->command[offset] = '\0';
+    return 0;
+}
+
+int modem_queue_submit(modem_cmd_t *cmd) {
+    if (cmd->state != MODEM_CMD_STATE_IDLE
+            || (unsigned) cmd->prio >= _MODEM_CMD_PRIO_COUNT
+            || (unsigned) cmd->channel >= _MODEM_CHANNEL_COUNT
+            || !cmd->responses_count) {
+        return -1;
+    }
+    cmd->next = NULL;
+    cmd->state = MODEM_CMD_STATE_QUEUED;
+
+    modem_cmd_t **tail = &queue_heads[cmd->prio];
+    while (*tail) {
+        tail = &(*tail)->next;
+    }
+    *tail = cmd;
+    return 0;
+}
+
+void modem_queue_cancel(modem_cmd_t *cmd) {
+    in_flight_t *in_flight = lane_of(cmd);
+    if (in_flight->active && in_flight->cmd == cmd) {
+        in_flight->cmd = NULL;
+    } else if (cmd->state == MODEM_CMD_STATE_QUEUED) {
+        for (modem_cmd_t **it = &queue_heads[cmd->prio]; *it;
+             it = &(*it)->next) {
+            if (*it == cmd) {
+                *it = cmd->next;
+                break;
+            }
+        }
+    }
+    cmd->state = MODEM_CMD_STATE_IDLE;
+    cmd->next = NULL;
+}
+
+bool modem_queue_idle(void) {
+    for (size_t i = 0; i < _MODEM_CHANNEL_COUNT; i++) {
+        if (in_flight_slots[i].active) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < _MODEM_CMD_PRIO_COUNT; i++) {
+        if (queue_heads[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int modem_queue_register_urc_handler(const char *prefix,
+                                     modem_urc_handler_t *handler) {
+    for (size_t i = 0; i < urc_handlers_count; i++) {
+        if (urc_handlers[i].handler == handler
+                && !strcmp(urc_handlers[i].prefix, prefix)) {
+            return 0;
+        }
+    }
+    if (urc_handlers_count >= MODEM_URC_HANDLERS_MAX) {
+        return -1;
+    }
+    urc_handlers[urc_handlers_count++] = (urc_entry_t) {
+        .prefix = prefix,
+        .handler = handler
+    };
+    return 0;
+}
+
+static void finish_in_flight(in_flight_t *in_flight, int result) {
+    modem_cmd_t *cmd = in_flight->cmd;
+    *in_flight = (in_flight_t) { 0 };
+    if (cmd) {
+        cmd->state = MODEM_CMD_STATE_IDLE;
+        if (cmd->finished_handler) {
+            cmd->finished_handler(cmd, result);
+        }
+    }
+}
+
+static int write_str(modem_channel_t channel, const char *str) {
+    return modem_cmux_write(channel, (const uint8_t *) str, strlen(str));
+}
+
+static void start_next(in_flight_t *in_flight) {
+    modem_cmd_t **it = NULL;
+    for (size_t i = 0; i < _MODEM_CMD_PRIO_COUNT; i++) {
+        for (it = &queue_heads[i]; *it && lane_of(*it) != in_flight;
+             it = &(*it)->next) {
+        }
+        if (*it) {
+            break;
+        }
+    }
+    if (!it || !*it) {
+        return;
+    }
+    modem_cmd_t *cmd = *it;
+    if (modem_tx_buf_free() < strlen(cmd->command) + MODEM_CMD_TX_RESERVE
+            || write_str(cmd->channel, cmd->command)
+            || (!cmd->payload_inline && write_str(cmd->channel, "\r\n"))
+            || modem_tx_start()) {
+        // TX buffer still busy with other data, retry later
+        return;
+    }
+    *it = cmd->next;
+    cmd->next = NULL;
+    if (cmd->payload_inline) {
+        cmd->state = MODEM_CMD_STATE_SEND_PAYLOAD;
+    } else {
+        cmd->state = cmd->payload ? MODEM_CMD_STATE_WAIT_PROMPT
+                                  : MODEM_CMD_STATE_WAIT_RESPONSE;
+    }
+    cmd->start_tick = HAL_GetTick();
+    *in_flight = (in_flight_t) {
+        .cmd = cmd,
+        .active = true,
+        .state = cmd->state,
+        .responses = cmd->responses,
+        .responses_count = cmd->responses_count,
+        .start_tick = cmd->start_tick,
+        .timeout_ms = cmd->timeout_ms
+    };
+}
+
+static void set_in_flight_state(in_flight_t *in_flight,
+                                modem_cmd_state_t state) {
+    in_flight->state = state;
+    if (in_flight->cmd) {
+        in_flight->cmd->state = state;
+    }
+}
+
+static int handle_prompt(in_flight_t *in_flight, modem_channel_t channel) {
+    if (modem_rx_pop_newlines() || modem_rx_seek(0) != '>') {
+        return 1;
+    }
+    modem_rx_advance(1); // skip the prompt
+
+    int res;
+    if (in_flight->cmd) {
+        if (!(res = modem_cmux_write(channel, in_flight->cmd->payload,
+                                     in_flight->cmd->payload_len))) {
+            // append Ctrl-Z to signal end of transmission
+            res = modem_cmux_write(channel, &(const uint8_t) { CTRL_Z }, 1);
+        }
+    } else {
+        // the command has been cancelled, abort sending
+        res = modem_cmux_write(channel, &(const uint8_t) { ESC }, 1);
+    }
+    if (res || modem_tx_start()) {
+        modem_log(L_ERROR, "failed to transmit command payload");
+        finish_in_flight(in_flight, -1);
+        return -1;
+    }
+    set_in_flight_state(in_flight, MODEM_CMD_STATE_WAIT_RESPONSE);
+    return 0;
+}
+
+// Writes as much of the inline payload as fits in the TX buffer, then ends
+// the command line. A cancelled command is just ended, the modem will respond
+// with an error.
+static void send_inline_payload(in_flight_t *in_flight,
+                               modem_channel_t channel) {
+    const modem_cmd_t *cmd = in_flight->cmd;
+    while (cmd && in_flight->payload_offset < cmd->payload_len) {
+        size_t free_space = modem_tx_buf_free();
+        if (free_space <= MODEM_CMD_TX_RESERVE) {
+            return;
+        }
+        size_t chunk_len =
+                ANJ_MIN(ANJ_MIN(cmd->payload_len - in_flight->payload_offset,
+                                free_space - MODEM_CMD_TX_RESERVE),
+                        INLINE_PAYLOAD_CHUNK);
+        if (modem_cmux_write(channel, cmd->payload + in_flight->payload_offset,
+                             chunk_len)
+                || modem_tx_start()) {
+            return;
+        }
+        in_flight->payload_offset += chunk_len;
+    }
+    if (write_str(channel, "\r\n") || modem_tx_start()) {
+        return;
+    }
+    set_in_flight_state(in_flight, MODEM_CMD_STATE_WAIT_RESPONSE);
+}
+
+static int dispatch_urc(size_t line_len) {
+    for (size_t i = 0; i < urc_handlers_count; i++) {
+        if (modem_rx_line_starts_with(urc_handlers[i].prefix, line_len)) {
+            int res = urc_handlers[i].handler(line_len);
+            return res > 0 ? 1 : 0;
+        }
+    }
+    return -1;
+}
+
+static bool match_response(in_flight_t *in_flight, size_t line_len) {
+    // NOTE: responses are matched while waiting for the prompt as well, so
+    // that e.g. ERROR returned instead of the prompt ends the command
+    if (!in_flight->active) {
+        return false;
+    }
+    for (size_t i = 0; i < in_flight->responses_count; i++) {
+        const modem_response_t *response = &in_flight->responses[i];
+        bool matches = response->prefix
+                               ? modem_rx_line_starts_with(response->response,
+                                                           line_len)
+                               : modem_rx_line_equals(response->response,
+                                                      line_len);
+        if (!matches) {
+            continue;
+        }
+        if (in_flight->cmd && in_flight->cmd->line_handler) {
+            char line[MODEM_CMD_LINE_MAX_LEN + 1];
+            size_t copied = modem_rx_copy(line, sizeof(line), line_len);
+            in_flight->cmd->line_handler(in_flight->cmd, line, copied);
+        }
+        modem_rx_advance(line_len);
+        if (response->return_code <= 0) {
+            finish_in_flight(in_flight, response->return_code);
+        }
+        return true;
+    }
+    return false;
+}
+
+static void dispatch_response(modem_channel_t channel, size_t line_len) {
+    if (match_response(&in_flight_slots[channel], line_len)) {
+        return;
+    }
+    if (modem_cmux_active() && channel == MODEM_CHANNEL_URC) {
+        // asynchronous final results, e.g. +QIOPEN, are reported on the URC
+        // channel, but belong to commands issued on other channels
+        for (size_t i = 0; i < _MODEM_CHANNEL_COUNT; i++) {
+            if (i != channel && match_response(&in_flight_slots[i], line_len)) {
+                return;
+            }
+        }
+    }
+    modem_rx_warn_and_advance(line_len);
+}
+
+static void process_lane(in_flight_t *in_flight, modem_channel_t channel) {
+    while (true) {
+        if (!in_flight->active) {
+            start_next(in_flight);
+        }
+        if (in_flight->active) {
+            if (HAL_GetTick() - in_flight->start_tick
+                    >= in_flight->timeout_ms) {
+                modem_log(L_WARNING, "command timed out");
+                finish_in_flight(in_flight, MODEM_CMD_ERR_TIMEOUT);
+                continue;
+            }
+            if (in_flight->state == MODEM_CMD_STATE_SEND_PAYLOAD) {
+                // if the TX buffer is full, the rest is sent on the next call;
+                // URCs may still arrive in the meantime
+                send_inline_payload(in_flight, channel);
+            } else if (in_flight->state == MODEM_CMD_STATE_WAIT_PROMPT) {
+                int res = handle_prompt(in_flight, channel);
+                if (res <= 0) {
+                    continue;
+                }
+                // no prompt yet, but there may be a URC or an error response
+            }
+        }
+
+        size_t line_len;
+        if (modem_rx_seek_line_length(&line_len)) {
+            return;
+        }
+        int res = dispatch_urc(line_len);
+        if (res > 0) {
+            // wait for the rest of the URC
+            return;
+        }
+        if (res < 0) {
+            dispatch_response(channel, line_len);
+        }
+    }
+}
+
+void modem_queue_enter_data_mode(modem_channel_t channel) {
+    data_mode[modem_cmux_active() ? channel : 0] = true;
+}
+
+bool modem_queue_in_data_mode(modem_channel_t channel) {
+    return data_mode[modem_cmux_active() ? channel : 0];
+}
+
+void modem_queue_process(void) {
+    if (modem_sleep_active()) {
+        // queued commands are sent once the UART is woken up
+        return;
+    }
+    modem_cmux_process();
+    // NOTE: URC handlers are dispatched on every channel, so it does not matter
+    // which one the modem chooses to report them on
+    for (size_t i = 0; i < lanes_count(); i++) {
+        if (data_mode[i]) {
+            continue;
+        }
+        modem_rx_set_source(modem_cmux_channel_buf((modem_channel_t) i));
+        process_lane(&in_flight_slots[i], (modem_channel_t) i);
+    }
+    modem_rx_set_source(NULL);
+}
@@ -0,0 +1,154 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#ifndef MODEM_QUEUE_H
+#define MODEM_QUEUE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "modem_cmux.h"
+
+#define MODEM_CMD_MAX_LEN 128
+// long enough for the fields of interest in AT+QENG="servingcell" responses
+#define MODEM_CMD_LINE_MAX_LEN 128
+#define MODEM_URC_HANDLERS_MAX 4
+// TX buffer space required on top of the command itself: CRLF and framing
+#define MODEM_CMD_TX_RESERVE 16
+
+/**
+ * Result passed to the finished handler if no final response arrived within
+ * the command's timeout.
+ */
+#define MODEM_CMD_ERR_TIMEOUT (-2)
+
+/**
+ * Commands with lower value are scheduled first. Commands with equal priority
+ * are executed in submission order. One command per channel can be in flight
+ * at a time; without CMUX all channels share a single one.
+ */
+typedef enum {
+    MODEM_CMD_PRIO_HIGH,   // socket data path
+    MODEM_CMD_PRIO_NORMAL, // socket control, bringup
+    MODEM_CMD_PRIO_LOW,    // periodic queries, e.g. signal quality
+    _MODEM_CMD_PRIO_COUNT
+} modem_cmd_prio_t;
+
+typedef struct {
+    const char *response;
+    // 0 ends the command with success, negative value ends it with an error,
+    // positive value marks an intermediate line and the command stays active
+    int return_code;
+    // if set, only the beginning of the line needs to match
+    bool prefix;
+} modem_response_t;
+
+typedef enum {
+    MODEM_CMD_STATE_IDLE,
+    MODEM_CMD_STATE_QUEUED,
+    MODEM_CMD_STATE_WAIT_PROMPT,
+    MODEM_CMD_STATE_SEND_PAYLOAD,
+    MODEM_CMD_STATE_WAIT_RESPONSE
+} modem_cmd_state_t;
+
+typedef struct modem_cmd_struct modem_cmd_t;
+
+/**
+ * Called for every line matched against the response table, before it is
+ * consumed. @p line is null-terminated and truncated to
+ * @ref MODEM_CMD_LINE_MAX_LEN characters.
+ */
+typedef void modem_cmd_line_handler_t(modem_cmd_t *cmd,
+                                      const char *line,
+                                      size_t line_len);
+
+/**
+ * Called once the command is finished, with @p result equal to the return code
+ * of the final response or @ref MODEM_CMD_ERR_TIMEOUT.
+ */
+typedef void modem_cmd_finished_handler_t(modem_cmd_t *cmd, int result);
+
+/**
+ * A single queue entry. Storage is owned by the submitter and must stay valid
+ * until the finished handler is called or the command is cancelled.
+ */
+struct modem_cmd_struct {
+    // command to send, without the trailing CRLF
+    char command[MODEM_CMD_MAX_LEN];
+    // optional data sent after the '>' prompt, terminated with Ctrl-Z
+    const uint8_t *payload;
+    size_t payload_len;
+    // if set, the payload is instead sent right after the command text, as
+    // a part of the same line; it may be longer than the TX buffer
+    bool payload_inline;
+    const modem_response_t *responses;
+    size_t responses_count;
+    uint32_t timeout_ms;
+    modem_cmd_prio_t prio;
+    modem_channel_t channel;
+    modem_cmd_line_handler_t *line_handler;
+    modem_cmd_finished_handler_t *finished_handler;
+    void *arg;
+
+    // private fields, managed by the queue
+    modem_cmd_state_t state;
+    uint32_t start_tick;
+    modem_cmd_t *next;
+};
+
+/**
+ * Handles an unsolicited result code, the first line of which is available
+ * in the RX buffer and has @p line_len characters.
+ *
+ * @returns 0 if the URC was consumed, a positive value if more data needs to
+ *          arrive before it can be consumed (nothing may be consumed in that
+ *          case), or a negative value if the URC was consumed but was invalid.
+ */
+typedef int modem_urc_handler_t(size_t line_len);
+
+/**
+ * Fills in the command text by concatenating @p parts.
+ */
+int modem_cmd_set_command(modem_cmd_t *cmd,
+                          const char *const *parts,
+                          size_t parts_count);
+
+int modem_queue_submit(modem_cmd_t *cmd);
+
+/**
+ * Removes the command from the queue. If the command is already in flight, the
+ * rest of its responses are skipped. The finished handler is not called.
+ */
+void modem_queue_cancel(modem_cmd_t *cmd);
+
+bool modem_queue_idle(void);
+
+int modem_queue_register_urc_handler(const char *prefix,
+                                     modem_urc_handler_t *handler);
+
+/**
+ * Stops parsing AT responses on @p channel, e.g. after it has been switched to
+ * PPP data mode. Without CMUX this stops parsing altogether.
+ */
+void modem_queue_enter_data_mode(modem_channel_t channel);
+
+/**
+ * Returns true if commands submitted on @p channel would never be answered,
+ * because it has been switched to data mode.
+ */
+bool modem_queue_in_data_mode(modem_channel_t channel);
+
+/**
+ * Sends queued commands and dispatches everything available in the RX buffer
+ * to URC handlers and the command in flight. Never blocks.
+ */
+void modem_queue_process(void);
+
+#endif // MODEM_QUEUE_H
@@ -0,0 +1,396 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <anj/log.h>
+#include <anj/utils.h>
+
+#include <stm32u3xx_hal.h>
+
+#include "modem_queue.h"
+#include "modem_radio.h"
+#include "modem_sleep.h"
+
+#define modem_log(...) anj_log(modem, __VA_ARGS__)
+
+#define RADIO_QUERY_TIMEOUT_MS 1000
+#define RADIO_DEFAULT_POLL_INTERVAL_MS 60000
+
+typedef enum {
+    QUERY_SIGNAL,
+    QUERY_CELL,
+#if !defined(CONFIG_NET_PPP) && !defined(CONFIG_NET_NIDD)
+    // in PPP mode the address is assigned by IPCP, and there's none with NIDD
+    QUERY_PDP,
+#endif // !defined(CONFIG_NET_PPP) && !defined(CONFIG_NET_NIDD)
+    _QUERY_COUNT
+} query_t;
+
+typedef struct {
+    const char *command;
+    const char *response_prefix;
+    // refresh period, as a multiple of the poll interval
+    uint32_t interval_multiplier;
+} query_def_t;
+
+static const query_def_t QUERIES[_QUERY_COUNT] = {
+    [QUERY_SIGNAL] = {
+        .command = "AT+QCSQ",
+        .response_prefix = "+QCSQ: ",
+        .interval_multiplier = 1
+    },
+    [QUERY_CELL] = {
+        .command = "AT+QENG=\"servingcell\"",
+        .response_prefix = "+QENG: \"servingcell\",",
+        .interval_multiplier = 4
+    },
+#if !defined(CONFIG_NET_PPP) && !defined(CONFIG_NET_NIDD)
+    [QUERY_PDP] = {
+        .command = "AT+QIACT?",
+        .response_prefix = "+QIACT: 1,",
+        .interval_multiplier = 16
+    },
+#endif // !defined(CONFIG_NET_PPP) && !defined(CONFIG_NET_NIDD)
+};
+
+static modem_radio_info_t info;
+// results of the query in flight, applied to info once it succeeds
+static modem_radio_info_t pending;
+static uint32_t poll_interval_ms = RADIO_DEFAULT_POLL_INTERVAL_MS;
+static uint32_t last_attempt_tick[_QUERY_COUNT];
+static bool attempted[_QUERY_COUNT];
+
+static modem_cmd_t query_cmd;
+static modem_response_t query_responses[3];
+static query_t query_in_flight;
+static bool query_active;
+static bool query_finished;
+static int query_result;
+
+// Finds the field with @p index in a comma-separated response line, after the
+// "+XXX: " header. Surrounding quotes are stripped.
+static bool get_field(const char *line,
+                      size_t index,
+                      const char **out_field,
+                      size_t *out_len) {
+    const char *field = strchr(line, ':');
+    if (!field) {
+        return false;
+    }
+    field++;
+    while (*field == ' ') {
+        field++;
+    }
+    for (size_t i = 0; i < index; i++) {
+        field = strchr(field, ',');
+        if (!field) {
+            return false;
+        }
+        field++;
+    }
+    const char *end = strchr(field, ',');
+    size_t len = end ? (size_t) (end - field) : strlen(field);
+    if (len >= 2 && field[0] == '"' && field[len - 1] == '"') {
+        field++;
+        len -= 2;
+    }
+    *out_field = field;
+    *out_len = len;
+    return len > 0;
+}
+
+static bool field_equals(const char *line, size_t index, const char *value) {
+    const char *field;
+    size_t len;
+    return get_field(line, index, &field, &len) && len == strlen(value)
+           && !memcmp(field, value, len);
+}
+
+static bool get_int_field(const char *line, size_t index, int32_t *out) {
+    const char *field;
+    size_t len;
+    int64_t value;
+    if (!get_field(line, index, &field, &len)
+            || anj_string_to_int64_value(&value, field, len)
+            || value < INT32_MIN || value > INT32_MAX) {
+        return false;
+    }
+    *out = (int32_t) value;
+    return true;
+}
+
+static bool get_hex_field(const char *line, size_t index, uint32_t *out) {
+    const char *field;
+    size_t len;
+    if (!get_field(line, index, &field, &len) || len > 8) {
+        return false;
+    }
+    uint32_t value = 0;
+    for (size_t i = 0; i < len; i++) {
+        char chr = field[i];
+        uint32_t digit;
+        if (chr >= '0' && chr <= '9') {
+            digit = (uint32_t) (chr - '0');
+        } else if (chr >= 'A' && chr <= 'F') {
+            digit = (uint32_t) (chr - 'A' + 10);
+        } else if (chr >= 'a' && chr <= 'f') {
+            digit = (uint32_t) (chr - 'a' + 10);
+        } else {
+            return false;
+        }
+        value = value << 4 | digit;
+    }
+    *out = value;
+    return true;
+}
+
+static modem_rat_t parse_rat(const char *line, size_t index) {
+    // AT+QCSQ and AT+QENG use different names for the same RATs
+    if (field_equals(line, index, "GSM")) {
+        return MODEM_RAT_GSM;
+    }
+    if (field_equals(line, index, "eMTC")
+            || field_equals(line, index, "CAT-M")) {
+        return MODEM_RAT_EMTC;
+    }
+    if (field_equals(line, index, "NBIoT")
+            || field_equals(line, index, "CAT-NB")) {
+        return MODEM_RAT_NBIOT;
+    }
+    return MODEM_RAT_UNKNOWN;
+}
+
+// +QCSQ: "GSM",<rssi>
+// +QCSQ: "eMTC"|"NBIoT",<rssi>,<rsrp>,<sinr>,<rsrq>
+// +QCSQ: "NOSERVICE"
+static void parse_signal(const char *line) {
+    pending.rat = parse_rat(line, 0);
+    int32_t sinr_raw = 0;
+    switch (pending.rat) {
+    case MODEM_RAT_GSM:
+        pending.signal_valid =
+                get_int_field(line, 1, &pending.signal_strength_dbm);
+        pending.rsrq_db = 0;
+        pending.sinr_db = 0;
+        break;
+    case MODEM_RAT_EMTC:
+    case MODEM_RAT_NBIOT:
+        pending.signal_valid =
+                get_int_field(line, 2, &pending.signal_strength_dbm)
+                && get_int_field(line, 3, &sinr_raw)
+                && get_int_field(line, 4, &pending.rsrq_db);
+        // reported in 1/5 dB steps, with 0 meaning -20 dB
+        pending.sinr_db = sinr_raw / 5 - 20;
+        break;
+    default:
+        pending.signal_valid = false;
+        break;
+    }
+}
+
+// +QENG: "servingcell",<state>,"GSM",<mcc>,<mnc>,<lac>,<cellid>,...
+// +QENG: "servingcell",<state>,"CAT-M"|"CAT-NB",<is_tdd>,<mcc>,<mnc>,<cellid>,
+//        <pcid>,<earfcn>,<freq_band_ind>,<ul_bandwidth>,<dl_bandwidth>,<tac>,
+//        ...
+static void parse_cell(const char *line) {
+    int32_t mcc = 0;
+    int32_t mnc = 0;
+    switch (parse_rat(line, 2)) {
+    case MODEM_RAT_GSM:
+        pending.cell_valid = get_int_field(line, 3, &mcc)
+                             && get_int_field(line, 4, &mnc)
+                             && get_hex_field(line, 5, &pending.area_code)
+                             && get_hex_field(line, 6, &pending.cell_id);
+        break;
+    case MODEM_RAT_EMTC:
+    case MODEM_RAT_NBIOT:
+        pending.cell_valid = get_int_field(line, 4, &mcc)
+                             && get_int_field(line, 5, &mnc)
+                             && get_hex_field(line, 6, &pending.cell_id)
+                             && get_hex_field(line, 12, &pending.area_code);
+        break;
+    default:
+        // e.g. "SEARCH" state, no serving cell
+        pending.cell_valid = false;
+        return;
+    }
+    pending.mcc = (uint16_t) mcc;
+    pending.mnc = (uint16_t) mnc;
+}
+
+#if !defined(CONFIG_NET_PPP) && !defined(CONFIG_NET_NIDD)
+// +QIACT: 1,<context_state>,<context_type>,"<IP_address>"
+static void parse_pdp(const char *line) {
+    const char *field;
+    size_t len;
+    pending.ip_valid = get_field(line, 3, &field, &len)
+                       && len < sizeof(pending.ip_address);
+    if (pending.ip_valid) {
+        memcpy(pending.ip_address, field, len);
+        pending.ip_address[len] = '\0';
+    }
+}
+#endif // !defined(CONFIG_NET_PPP) && !defined(CONFIG_NET_NIDD)
+
+static void query_line_handler(modem_cmd_t *cmd,
+                               const char *line,
+                               size_t line_len) {
+    (void) cmd;
+    (void) line_len;
+    switch (query_in_flight) {
+    case QUERY_SIGNAL:
+        parse_signal(line);
+        break;
+    case QUERY_CELL:
+        parse_cell(line);
+        break;
+#if !defined(CONFIG_NET_PPP) && !defined(CONFIG_NET_NIDD)
+    case QUERY_PDP:
+        parse_pdp(line);
+        break;
+#endif // !defined(CONFIG_NET_PPP) && !defined(CONFIG_NET_NIDD)
+    default:
+        break;
+    }
+}
+
+static void query_finished_handler(modem_cmd_t *cmd, int result) {
+    (void) cmd;
+    query_finished = true;
+    query_result = result;
+}
+
+static void apply_pending(void) {
+    uint32_t now = HAL_GetTick();
+    bool changed = false;
+    switch (query_in_flight) {
+    case QUERY_SIGNAL:
+        changed = pending.signal_valid != info.signal_valid
+                  || pending.rat != info.rat
+                  || pending.signal_strength_dbm != info.signal_strength_dbm
+                  || pending.rsrq_db != info.rsrq_db
+                  || pending.sinr_db != info.sinr_db;
+        info.signal_valid = pending.signal_valid;
+        info.rat = pending.rat;
+        info.signal_strength_dbm = pending.signal_strength_dbm;
+        info.rsrq_db = pending.rsrq_db;
+        info.sinr_db = pending.sinr_db;
+        info.signal_tick = now;
+        break;
+    case QUERY_CELL:
+        changed = pending.cell_valid != info.cell_valid
+                  || pending.cell_id != info.cell_id
+                  || pending.area_code != info.area_code
+                  || pending.mcc != info.mcc || pending.mnc != info.mnc;
+        info.cell_valid = pending.cell_valid;
+        info.cell_id = pending.cell_id;
+        info.area_code = pending.area_code;
+        info.mcc = pending.mcc;
+        info.mnc = pending.mnc;
+        info.cell_tick = now;
+        break;
+#if !defined(CONFIG_NET_PPP) && !defined(CONFIG_NET_NIDD)
+    case QUERY_PDP:
+        changed = pending.ip_valid != info.ip_valid
+                  || strcmp(pending.ip_address, info.ip_address);
+        info.ip_valid = pending.ip_valid;
+        memcpy(info.ip_address, pending.ip_address, sizeof(info.ip_address));
+        info.ip_tick = now;
+        break;
+#endif // !defined(CONFIG_NET_PPP) && !defined(CONFIG_NET_NIDD)
+    default:
+        break;
+    }
+    if (changed) {
+        info.generation++;
+    }
+}
+
+static int submit_query(query_t query) {
+    const query_def_t *def = &QUERIES[query];
+    query_responses[0] = (modem_response_t) { def->response_prefix, 1, true };
+    query_responses[1] = (modem_response_t) { "OK", 0, false };
+    query_responses[2] = (modem_response_t) { "ERROR", -1, false };
+    query_cmd = (modem_cmd_t) {
+        .responses = query_responses,
+        .responses_count = ANJ_ARRAY_SIZE(query_responses),
+        .timeout_ms = RADIO_QUERY_TIMEOUT_MS,
+        .prio = MODEM_CMD_PRIO_LOW,
+        .channel = MODEM_CHANNEL_CONTROL,
+        .line_handler = query_line_handler,
+        .finished_handler = query_finished_handler
+    };
+    if (modem_cmd_set_command(&query_cmd, &def->command, 1)) {
+        return -1;
+    }
+    // a response line that does not arrive leaves the values invalid
+    pending = info;
+    pending.signal_valid = false;
+    pending.cell_valid = false;
+    pending.ip_valid = false;
+    query_in_flight = query;
+    query_finished = false;
+    return modem_queue_submit(&query_cmd);
+}
+
+// Picks the first query whose refresh period has elapsed
+static bool next_due_query(query_t *out_query) {
+    uint32_t now = HAL_GetTick();
+    for (size_t i = 0; i < _QUERY_COUNT; i++) {
+        uint32_t period = poll_interval_ms * QUERIES[i].interval_multiplier;
+        if (!attempted[i] || now - last_attempt_tick[i] >= period) {
+            *out_query = (query_t) i;
+            return true;
+        }
+    }
+    return false;
+}
+
+void modem_radio_set_poll_interval(uint32_t interval_ms) {
+    poll_interval_ms = interval_ms;
+}
+
+void modem_radio_poll(void) {
+    if (query_active) {
+        modem_queue_process();
+        if (!query_finished) {
+            return;
+        }
+        query_active = false;
+        if (query_result == 0) {
+            apply_pending();
+        } else {
+            modem_log(L_DEBUG, "%s failed: %d",
+                      QUERIES[query_in_flight].command, query_result);
+        }
+    }
+    // NOTE: the poller never wakes the modem up; values just get older while
+    // it sleeps
+    if (modem_sleep_active() || modem_queue_in_data_mode(MODEM_CHANNEL_CONTROL)
+            || !modem_queue_idle()) {
+        return;
+    }
+    query_t query;
+    if (!next_due_query(&query)) {
+        return;
+    }
+    // failed queries are also retried only after the refresh period
+    attempted[query] = true;
+    last_attempt_tick[query] = HAL_GetTick();
+    if (!submit_query(query)) {
+        query_active = true;
+    }
+}
+
+const modem_radio_info_t *modem_radio_info(void) {
+    return &info;
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#ifndef MODEM_RADIO_H
+#define MODEM_RADIO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef enum {
+    MODEM_RAT_UNKNOWN,
+    MODEM_RAT_GSM,
+    MODEM_RAT_EMTC,
+    MODEM_RAT_NBIOT
+} modem_rat_t;
+
+/**
+ * Radio metrics cached by the background poller. Every group is refreshed by
+ * a single query; the tick of the last successful refresh is kept, so that
+ * the age of the values can be determined.
+ */
+typedef struct {
+    // AT+QCSQ
+    bool signal_valid;
+    uint32_t signal_tick;
+    modem_rat_t rat;
+    // RSSI for GSM, RSRP for LTE
+    int32_t signal_strength_dbm;
+    // RSRQ, LTE only
+    int32_t rsrq_db;
+    // SINR, LTE only
+    int32_t sinr_db;
+
+    // AT+QENG="servingcell"
+    bool cell_valid;
+    uint32_t cell_tick;
+    uint32_t cell_id;
+    // LAC for GSM, TAC for LTE
+    uint32_t area_code;
+    uint16_t mcc;
+    uint16_t mnc;
+
+    // AT+QIACT?
+    bool ip_valid;
+    uint32_t ip_tick;
+    char ip_address[40];
+
+    // incremented whenever any of the values above changes
+    uint32_t generation;
+} modem_radio_info_t;
+
+/**
+ * Sets how often the signal metrics are refreshed. Serving cell and PDP
+ * context information changes less often, so it's refreshed at a fraction of
+ * that rate.
+ */
+void modem_radio_set_poll_interval(uint32_t interval_ms);
+
+/**
+ * Submits the next query if one is due and the command queue is idle, and
+ * collects the results. Queries are only sent while the modem is awake and
+ * nothing else is using it, so that they never delay socket traffic. Never
+ * blocks; call periodically.
+ */
+void modem_radio_poll(void);
+
+const modem_radio_info_t *modem_radio_info(void);
+
+#endif // MODEM_RADIO_H
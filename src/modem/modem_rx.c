@@ -12,6 +12,8 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <anj/utils.h>
+
 #include <stm32u3xx_hal.h>
 #include <usart.h>
 
@@ -27,6 +29,10 @@ static circ_buf_t rx_buf = {
     .storage = rx_buf_storage
 };
 
+// buffer the line parsing functions below operate on; it's the raw UART stream
+// unless a multiplexing layer demultiplexes it into per-channel buffers
+static circ_buf_t *source = &rx_buf;
+
 // NOTE: since project has been generated with USE_HAL_UART_REGISTER_CALLBACKS
 // disabled, we can only override the callback that handles all UARTs. In case
 // we'd like to support multiple UARTs, the CubeMX-generated code should be
@@ -44,6 +50,14 @@ void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart) {
     }
 }
 
+circ_buf_t *modem_rx_raw_buf(void) {
+    return &rx_buf;
+}
+
+void modem_rx_set_source(circ_buf_t *buf) {
+    source = buf ? buf : &rx_buf;
+}
+
 int modem_rx_start(void) {
     // start chain of interrupts
     if (HAL_UART_Receive_IT(&hlpuart1, &byte, 1) != HAL_OK)
@@ -52,16 +66,23 @@ int modem_rx_start(void) {
     return 0;
 }
 
+int modem_rx_stop(void) {
+    if (HAL_UART_AbortReceive(&hlpuart1) != HAL_OK) {
+        return -1;
+    }
+    return 0;
+}
+
 static inline bool is_newline(char chr) {
     return chr == '\r' || chr == '\n';
 }
 
 bool modem_rx_pop_newlines(void) {
-    while (circ_buf_avail(&rx_buf) > 0) {
-        if (!is_newline(circ_buf_seek(&rx_buf, 0))) {
+    while (circ_buf_avail(source) > 0) {
+        if (!is_newline(circ_buf_seek(source, 0))) {
             return false;
         }
-        circ_buf_advance(&rx_buf);
+        circ_buf_advance(source);
     }
     return true;
 }
@@ -71,8 +92,8 @@ int modem_rx_seek_line_length(size_t *out_line_len) {
         return -1;
     }
 
-    for (size_t i = 0; i < circ_buf_avail(&rx_buf); i++) {
-        if (is_newline(circ_buf_seek(&rx_buf, i))) {
+    for (size_t i = 0; i < circ_buf_avail(source); i++) {
+        if (is_newline(circ_buf_seek(source, i))) {
             // now first *out_line_len chars in buffer
             // are valid characters of a line
             *out_line_len = i;
@@ -84,21 +105,51 @@ int modem_rx_seek_line_length(size_t *out_line_len) {
 }
 
 void modem_rx_advance(size_t len) {
-    circ_buf_advance_n(&rx_buf, len);
+    circ_buf_advance_n(source, len);
 }
 
 char modem_rx_seek(size_t at) {
-    return circ_buf_seek(&rx_buf, at);
+    return circ_buf_seek(source, at);
 }
 
 char modem_rx_pop(void) {
-    return circ_buf_pop(&rx_buf);
+    return circ_buf_pop(source);
 }
 
 void modem_rx_buf_flush(void) {
-    return circ_buf_flush(&rx_buf);
+    return circ_buf_flush(source);
 }
 
 size_t modem_rx_buf_avail(void) {
-    return circ_buf_avail(&rx_buf);
+    return circ_buf_avail(source);
+}
+
+bool modem_rx_line_starts_with(const char *str, size_t line_len) {
+    size_t i = 0;
+    while (str[i] != '\0' && i < line_len) {
+        if (modem_rx_seek(i) != str[i]) {
+            return false;
+        }
+        i++;
+    }
+    return str[i] == '\0';
+}
+
+bool modem_rx_line_equals(const char *str, size_t line_len) {
+    for (size_t i = 0; i < line_len; i++) {
+        if (str[i] == '\0' || modem_rx_seek(i) != str[i]) {
+            return false;
+        }
+    }
+
+    return str[line_len] == '\0';
+}
+
+size_t modem_rx_copy(char *out, size_t out_size, size_t len) {
+    size_t to_copy = ANJ_MIN(len, out_size - 1);
+    for (size_t i = 0; i < to_copy; i++) {
+        out[i] = modem_rx_seek(i);
+    }
+    out[to_copy] = '\0';
+    return to_copy;
 }
@@ -13,7 +13,42 @@
 #include <stdbool.h>
 #include <stddef.h>
 
+#include <anj/log.h>
+#include <anj/utils.h>
+
+#include "circ_buf.h"
+
+// NOTE: implemented as macro to correctly report the line number
+#define modem_rx_warn_and_advance(Len)                                     \
+    do {                                                                   \
+        size_t To_seek = ANJ_MIN(Len, 64);                                 \
+        char Buf[64 + 1];                                                  \
+        size_t I = 0;                                                      \
+        for (; I < To_seek; I++) {                                         \
+            Buf[I] = modem_rx_seek(I);                                     \
+        }                                                                  \
+        Buf[I] = '\0';                                                     \
+        if (Len > 64) {                                                    \
+            anj_log(modem, L_WARNING, "skipping RX (len: %u): %s...",      \
+                    (unsigned) Len, Buf);                                  \
+        } else {                                                           \
+            anj_log(modem, L_WARNING, "skipping RX (len: %u): %s",         \
+                    (unsigned) Len, Buf);                                  \
+        }                                                                  \
+        modem_rx_advance(Len);                                             \
+    } while (0)
+
 int modem_rx_start(void);
+// stops the chain of RX interrupts; data received afterwards is lost
+int modem_rx_stop(void);
+
+circ_buf_t *modem_rx_raw_buf(void);
+/**
+ * Selects the buffer all functions below operate on. NULL selects the raw UART
+ * stream, which is also the default.
+ */
+void modem_rx_set_source(circ_buf_t *buf);
+
 bool modem_rx_pop_newlines(void);
 int modem_rx_seek_line_length(size_t *out_line_len);
 void modem_rx_advance(size_t len);
@@ -22,4 +57,15 @@ char modem_rx_pop(void);
 void modem_rx_buf_flush(void);
 size_t modem_rx_buf_avail(void);
 
+bool modem_rx_line_starts_with(const char *str, size_t line_len);
+bool modem_rx_line_equals(const char *str, size_t line_len);
+/**
+ * Copies up to @p len characters from the beginning of the RX buffer into
+ * @p out (without consuming them) and null-terminates the result. The copy is
+ * truncated if @p out is too small.
+ *
+ * @returns Number of characters copied, excluding the null terminator.
+ */
+size_t modem_rx_copy(char *out, size_t out_size, size_t len);
+
 #endif // MODEM_RX_H
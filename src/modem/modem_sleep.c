@@ -0,0 +1,175 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <anj/log.h>
+#include <anj/utils.h>
+
+#include <stm32u3xx_hal.h>
+
+#include "modem_cmux.h"
+#include "modem_constants.h"
+#include "modem_queue.h"
+#include "modem_rx.h"
+#include "modem_sleep.h"
+#include "modem_tx.h"
+
+#define modem_log(...) anj_log(modem, __VA_ARGS__)
+
+typedef enum {
+    SLEEP_STATE_AWAKE,
+    SLEEP_STATE_ASLEEP,
+    SLEEP_STATE_WAKING
+} sleep_state_t;
+
+static sleep_state_t state;
+// set once the modem has accepted AT+QSCLK=1
+static bool sleep_enabled;
+static uint32_t wake_start_tick;
+static modem_sleep_stats_t stats;
+
+static modem_cmd_t probe_cmd;
+static bool probe_finished;
+static int probe_result;
+
+// NOTE: with AT+QSCLK=1, BG96 enters sleep mode only while DTR is pulled high,
+// and the UART is not usable until DTR is pulled low again. Without DTR, the
+// modem stays awake and may report URCs at any time, so the UART is left on.
+#ifdef MODEM_SLEEP_WITH_DTR
+static void set_dtr(GPIO_PinState sleep_allowed) {
+    HAL_GPIO_WritePin(CONFIG_MODEM_DTR_PORT, CONFIG_MODEM_DTR_PIN,
+                      sleep_allowed);
+}
+#endif // MODEM_SLEEP_WITH_DTR
+
+void modem_sleep_init(void) {
+    sleep_enabled = false;
+#ifdef MODEM_SLEEP_WITH_DTR
+    // NOTE: the GPIO port clock is expected to be enabled by MX_GPIO_Init()
+    GPIO_InitTypeDef gpio_init = {
+        .Pin = CONFIG_MODEM_DTR_PIN,
+        .Mode = GPIO_MODE_OUTPUT_PP,
+        .Pull = GPIO_NOPULL,
+        .Speed = GPIO_SPEED_FREQ_LOW
+    };
+    set_dtr(GPIO_PIN_RESET);
+    HAL_GPIO_Init(CONFIG_MODEM_DTR_PORT, &gpio_init);
+#endif // MODEM_SLEEP_WITH_DTR
+}
+
+void modem_sleep_allow(void) {
+    sleep_enabled = true;
+}
+
+int modem_sleep_enter(void) {
+    if (state != SLEEP_STATE_AWAKE || !sleep_enabled) {
+        return 0;
+    }
+    if (modem_cmux_active() || !modem_queue_idle() || !modem_tx_idle()) {
+        modem_log(L_DEBUG, "modem busy, not entering sleep");
+        return 0;
+    }
+    if (modem_rx_stop()) {
+        return -1;
+    }
+    __HAL_RCC_LPUART1_CLK_DISABLE();
+#ifdef MODEM_SLEEP_WITH_DTR
+    set_dtr(GPIO_PIN_SET);
+#endif // MODEM_SLEEP_WITH_DTR
+    state = SLEEP_STATE_ASLEEP;
+    stats.sleeps++;
+    return 0;
+}
+
+static void probe_finished_handler(modem_cmd_t *cmd, int result) {
+    (void) cmd;
+    probe_finished = true;
+    probe_result = result;
+}
+
+static int submit_probe(void) {
+    static const modem_response_t responses[] = {
+        { "OK", 0, false },
+        { "ERROR", -1, false }
+    };
+    probe_cmd = (modem_cmd_t) {
+        .command = "AT",
+        .responses = responses,
+        .responses_count = ANJ_ARRAY_SIZE(responses),
+        .timeout_ms = MODEM_WAKE_PROBE_TIMEOUT_MS,
+        .prio = MODEM_CMD_PRIO_HIGH,
+        .channel = MODEM_CHANNEL_CONTROL,
+        .finished_handler = probe_finished_handler
+    };
+    probe_finished = false;
+    return modem_queue_submit(&probe_cmd);
+}
+
+static void wake_finished(void) {
+    uint32_t latency = HAL_GetTick() - wake_start_tick;
+    stats.last_wake_latency_ms = latency;
+    stats.max_wake_latency_ms = ANJ_MAX(stats.max_wake_latency_ms, latency);
+    modem_log(L_DEBUG, "modem woken up in %u ms", (unsigned) latency);
+    state = SLEEP_STATE_AWAKE;
+}
+
+int modem_sleep_wake(void) {
+    switch (state) {
+    case SLEEP_STATE_AWAKE: {
+        return 0;
+    }
+    case SLEEP_STATE_ASLEEP: {
+        wake_start_tick = HAL_GetTick();
+        __HAL_RCC_LPUART1_CLK_ENABLE();
+        if (modem_rx_start()) {
+            return -1;
+        }
+#ifdef MODEM_SLEEP_WITH_DTR
+        set_dtr(GPIO_PIN_RESET);
+        if (submit_probe()) {
+            return -1;
+        }
+        state = SLEEP_STATE_WAKING;
+        return 1;
+#else  // MODEM_SLEEP_WITH_DTR
+        wake_finished();
+        return 0;
+#endif // MODEM_SLEEP_WITH_DTR
+    }
+    case SLEEP_STATE_WAKING: {
+        modem_queue_process();
+        if (!probe_finished) {
+            return 1;
+        }
+        if (probe_result == 0) {
+            wake_finished();
+            return 0;
+        }
+        if (HAL_GetTick() - wake_start_tick >= MODEM_WAKE_TIMEOUT_MS) {
+            modem_log(L_ERROR, "modem did not wake up");
+            // let the caller retry or fail on the next command
+            state = SLEEP_STATE_AWAKE;
+            return -1;
+        }
+        // the modem may need more time after DTR is pulled low, try again
+        return submit_probe() ? -1 : 1;
+    }
+    default: { return -1; }
+    }
+}
+
+bool modem_sleep_active(void) {
+    return state == SLEEP_STATE_ASLEEP;
+}
+
+const modem_sleep_stats_t *modem_sleep_stats(void) {
+    return &stats;
+}
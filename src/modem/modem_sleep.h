@@ -0,0 +1,69 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#ifndef MODEM_SLEEP_H
+#define MODEM_SLEEP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#if defined(CONFIG_MODEM_DTR_PORT) && defined(CONFIG_MODEM_DTR_PIN)
+#    define MODEM_SLEEP_WITH_DTR
+#endif // defined(CONFIG_MODEM_DTR_PORT) && defined(CONFIG_MODEM_DTR_PIN)
+
+typedef struct {
+    uint32_t sleeps;
+    // time from the start of wakeup until the modem responded to AT
+    uint32_t last_wake_latency_ms;
+    uint32_t max_wake_latency_ms;
+} modem_sleep_stats_t;
+
+/**
+ * Configures the DTR line, if connected. Called during bringup.
+ */
+void modem_sleep_init(void);
+
+/**
+ * Lets @ref modem_sleep_enter power the UART down. Called during bringup once
+ * the modem has accepted AT+QSCLK=1, which requires the DTR line.
+ */
+void modem_sleep_allow(void);
+
+/**
+ * Stops receiving from the modem: the RX interrupt chain is stopped, the
+ * LPUART clock is gated, and the modem is allowed to enter sleep mode with
+ * the DTR line.
+ *
+ * Does nothing unless allowed with @ref modem_sleep_allow, i.e. without the
+ * DTR line, as the modem then stays awake and URCs would be lost. Also does
+ * nothing if there are commands in progress or CMUX is active, as CMUX power
+ * saving is not supported.
+ *
+ * @returns 0 on success, negative value in case of an error.
+ */
+int modem_sleep_enter(void);
+
+/**
+ * Wakes the modem and the UART up, if needed. Must be called before issuing
+ * any commands after @ref modem_sleep_enter.
+ *
+ * @returns 0 if awake, 1 if waking up is in progress, negative value in case
+ *          the modem did not respond.
+ */
+int modem_sleep_wake(void);
+
+/**
+ * Returns true between @ref modem_sleep_enter and @ref modem_sleep_wake, i.e.
+ * while the UART is powered down.
+ */
+bool modem_sleep_active(void);
+
+const modem_sleep_stats_t *modem_sleep_stats(void);
+
+#endif // MODEM_SLEEP_H
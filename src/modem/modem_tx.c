@@ -27,7 +27,9 @@ static circ_buf_t tx_buf = {
 };
 
 static void tx_char(UART_HandleTypeDef *uart) {
-    uint8_t byte = circ_buf_pop(&tx_buf);
+    // HAL keeps the pointer until the byte is actually shifted out
+    static uint8_t byte;
+    byte = circ_buf_pop(&tx_buf);
     HAL_UART_Transmit_IT(uart, &byte, 1);
 }
 
@@ -49,23 +51,31 @@ int modem_tx_append_str(const char *str) {
     return modem_tx_append((const uint8_t *) str, strlen(str));
 }
 
+// NOTE: appending while transmission is ongoing is safe, as the buffer is
+// single-producer, single-consumer; the interrupt chain picks up new data
+// as long as it is still running
 int modem_tx_append(const uint8_t *buf, size_t len) {
-    if (tx_ongoing) {
-        return -1;
-    }
     return circ_buf_append(&tx_buf, buf, len);
 }
 
 int modem_tx_start(void) {
-    if (tx_ongoing) {
-        return -1;
-    }
-    if (circ_buf_avail(&tx_buf) == 0) {
-        return 0;
+    // the interrupt chain might be just finishing, so check its state and
+    // restart it atomically
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (!tx_ongoing && circ_buf_avail(&tx_buf) > 0) {
+        tx_ongoing = true;
+        tx_char(&hlpuart1);
     }
-
-    tx_ongoing = true;
-    tx_char(&hlpuart1);
+    __set_PRIMASK(primask);
 
     return 0;
 }
+
+size_t modem_tx_buf_free(void) {
+    return circ_buf_free(&tx_buf);
+}
+
+bool modem_tx_idle(void) {
+    return !tx_ongoing && circ_buf_avail(&tx_buf) == 0;
+}
@@ -17,5 +17,8 @@
 int modem_tx_append(const uint8_t *buf, size_t len);
 int modem_tx_append_str(const char *str);
 int modem_tx_start(void);
+size_t modem_tx_buf_free(void);
+// true if all queued data has been shifted out
+bool modem_tx_idle(void);
 
 #endif // MODEM_TX_H
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <stm32u3xx_hal.h>
+#include <stm32u3xx_ll_rcc.h>
+#include <usart.h>
+
+#include "modem/modem_tx.h"
+#include "timebase.h"
+
+#include "power.h"
+
+// Entering and leaving Stop 2 takes tens of microseconds, plus the clock
+// restore; shorter sleeps are not worth it and are done in Sleep mode
+#define POWER_STOP2_MIN_SLEEP_US 3000
+
+static power_stats_t stats;
+static uint32_t stop2_holds;
+
+void power_init(void) {
+    // NOTE: LPUART1 runs from HSI16, which is started on demand in Stop mode
+    // when a start bit is detected. The byte is then received as usual and the
+    // RXNE interrupt, enabled by the RX interrupt chain, wakes the CPU up.
+    HAL_UARTEx_EnableStopMode(&hlpuart1);
+}
+
+static bool uart_busy(void) {
+    return !modem_tx_idle() || __HAL_UART_GET_FLAG(&hlpuart1, UART_FLAG_BUSY);
+}
+
+// After Stop mode, the system runs from MSIS limited to 48 MHz, in voltage
+// range 2 and with the EPOD booster not ready. This brings back the state set
+// up by SystemClock_Config() with direct register accesses, without the
+// overhead of HAL_RCC_OscConfig(); interrupts are handled in the meantime, at
+// the lower frequency.
+static void restore_clocks(uint32_t msis_source, uint32_t msis_div) {
+    SET_BIT(PWR->VOSR, PWR_VOSR_BOOSTEN);
+    while (!READ_BIT(PWR->VOSR, PWR_VOSR_BOOSTRDY)) {
+    }
+    SET_BIT(PWR->VOSR, PWR_VOSR_R1EN);
+    while (!READ_BIT(PWR->VOSR, PWR_VOSR_R1RDY)) {
+    }
+    // flash latency is retained and already suits the full frequency
+    LL_RCC_MSIS_SetClockSource(msis_source);
+    LL_RCC_MSIS_SetClockDivision(msis_div);
+    while (!LL_RCC_MSIS_IsReady()) {
+    }
+}
+
+static void enter_stop2(void) {
+    uint32_t msis_source = LL_RCC_MSIS_GetClockSource();
+    uint32_t msis_div = LL_RCC_MSIS_GetClockDivision();
+    // NOTE: the event register must not be cleared, see event_loop_init()
+    HAL_PWR_EnterSTOPMode(PWR_LOWPOWERMODE_STOP2,
+                          PWR_STOPENTRY_WFE_NO_EVT_CLEAR);
+    uint64_t wakeup_us = timebase_now_us();
+    restore_clocks(msis_source, msis_div);
+    uint64_t restore_us = timebase_now_us() - wakeup_us;
+    stats.last_restore_us = (uint32_t) restore_us;
+    if (stats.last_restore_us > stats.max_restore_us) {
+        stats.max_restore_us = stats.last_restore_us;
+    }
+}
+
+power_state_t power_sleep(uint64_t deadline_us) {
+    uint64_t start_us = timebase_now_us();
+    power_state_t state = POWER_STATE_SLEEP;
+    if (deadline_us >= start_us + POWER_STOP2_MIN_SLEEP_US && !stop2_holds
+            && !uart_busy()) {
+        state = POWER_STATE_STOP2;
+        enter_stop2();
+    } else {
+        __WFE();
+    }
+    stats.residency_us[state] += timebase_now_us() - start_us;
+    stats.entries[state]++;
+    return state;
+}
+
+void power_hold_stop2(bool hold) {
+    if (hold) {
+        stop2_holds++;
+    } else if (stop2_holds) {
+        stop2_holds--;
+    }
+}
+
+const power_stats_t *power_stats(void) {
+    uint64_t now = timebase_now_us();
+    stats.residency_us[POWER_STATE_RUN] =
+            now - stats.residency_us[POWER_STATE_SLEEP]
+            - stats.residency_us[POWER_STATE_STOP2];
+    return &stats;
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#ifndef POWER_H
+#define POWER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef enum {
+    POWER_STATE_RUN,
+    // CPU clock gated, everything else running
+    POWER_STATE_SLEEP,
+    // all clocks in the core domain stopped, except for LSE and the kernel
+    // clocks requested by wakeup capable peripherals (LPTIM1, LPUART1)
+    POWER_STATE_STOP2,
+    _POWER_STATE_COUNT
+} power_state_t;
+
+typedef struct {
+    // time spent in each state since boot; the RUN entry is up to date only
+    // in values returned by @ref power_stats
+    uint64_t residency_us[_POWER_STATE_COUNT];
+    uint32_t entries[_POWER_STATE_COUNT];
+    // time from the wakeup until the system clock is back at full speed
+    uint32_t last_restore_us;
+    uint32_t max_restore_us;
+} power_stats_t;
+
+/**
+ * Enables LPUART1 wakeup from Stop mode, so that data from the modem arriving
+ * during Stop 2 wakes the CPU up instead of being lost. Must be called after
+ * the UART has been initialized.
+ */
+void power_init(void);
+
+/**
+ * Sleeps until @p deadline_us or until an interrupt, in the deepest state that
+ * is safe: Stop 2 if the deadline is far enough, no UART transfer is in
+ * progress and Stop 2 is not held off with @ref power_hold_stop2, Sleep
+ * otherwise. After Stop 2, the system clock configuration from
+ * SystemClock_Config() is restored before returning.
+ *
+ * The wakeup timer for @p deadline_us must already be programmed. Interrupts
+ * handled since the last call make this function return immediately, see
+ * @ref event_loop_init.
+ *
+ * @returns State that has been entered.
+ */
+power_state_t power_sleep(uint64_t deadline_us);
+
+/**
+ * Keeps @ref power_sleep out of Stop 2 while @p hold is true, for peripherals
+ * that don't run in it (e.g. the ADC). Holds are counted, each true call must
+ * be balanced with a false one.
+ */
+void power_hold_stop2(bool hold);
+
+const power_stats_t *power_stats(void);
+
+#endif // POWER_H
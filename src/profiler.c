@@ -0,0 +1,226 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#include <inttypes.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <anj/log.h>
+#include <anj/utils.h>
+
+#include <mbedtls/cipher.h>
+#include <mbedtls/ssl.h>
+
+#include <stm32u3xx.h>
+
+#include "profiler.h"
+
+#ifdef CONFIG_PROFILER
+
+#    define profiler_log_msg(...) anj_log(profiler, __VA_ARGS__)
+
+static const char *const PROBE_NAMES[] = {
+    [PROFILER_PROBE_ANJ_CORE_STEP] = "anj_core_step",
+    [PROFILER_PROBE_URC_BUFFER_HANDLER] = "urc_buffer_handler",
+    [PROFILER_PROBE_LPUART_ISR] = "lpuart_isr",
+    [PROFILER_PROBE_DTLS_HANDSHAKE] = "dtls_handshake",
+    [PROFILER_PROBE_DTLS_ENCRYPT] = "dtls_encrypt",
+    [PROFILER_PROBE_DTLS_DECRYPT] = "dtls_decrypt",
+    [PROFILER_PROBE_READ_SENSORS] = "read_sensors",
+};
+
+ANJ_STATIC_ASSERT(ANJ_ARRAY_SIZE(PROBE_NAMES) == _PROFILER_PROBE_COUNT,
+                  profiler_probe_names_mismatch);
+
+static profiler_stats_t stats[_PROFILER_PROBE_COUNT];
+
+// Values below 4 have their own buckets; above that, each power of two is
+// split into 4 buckets by the two bits below the most significant one
+static uint32_t bucket_index(uint32_t cycles) {
+    if (cycles < 4) {
+        return cycles;
+    }
+    uint32_t msb = 31 - __CLZ(cycles);
+    return (msb - 1) * 4 + ((cycles >> (msb - 2)) & 3);
+}
+
+static uint32_t bucket_lower_bound(uint32_t index) {
+    if (index < 4) {
+        return index;
+    }
+    return (4 + index % 4) << (index / 4 - 1);
+}
+
+void profiler_init(void) {
+    SET_BIT(DCB->DEMCR, DCB_DEMCR_TRCENA_Msk);
+    DWT->CYCCNT = 0;
+    SET_BIT(DWT->CTRL, DWT_CTRL_CYCCNTENA_Msk);
+    for (size_t i = 0; i < _PROFILER_PROBE_COUNT; i++) {
+        profiler_reset((profiler_probe_t) i);
+    }
+}
+
+void profiler_record(profiler_probe_t probe, uint32_t cycles) {
+    profiler_stats_t *probe_stats = &stats[probe];
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    probe_stats->count++;
+    probe_stats->sum_cycles += cycles;
+    if (cycles < probe_stats->min_cycles) {
+        probe_stats->min_cycles = cycles;
+    }
+    if (cycles > probe_stats->max_cycles) {
+        probe_stats->max_cycles = cycles;
+    }
+    probe_stats->histogram[bucket_index(cycles)]++;
+    __set_PRIMASK(primask);
+}
+
+const char *profiler_probe_name(profiler_probe_t probe) {
+    return PROBE_NAMES[probe];
+}
+
+void profiler_stats(profiler_probe_t probe, profiler_stats_t *out_stats) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    *out_stats = stats[probe];
+    __set_PRIMASK(primask);
+}
+
+uint32_t profiler_percentile(const profiler_stats_t *probe_stats,
+                             uint32_t percent) {
+    if (!probe_stats->count) {
+        return 0;
+    }
+    uint64_t target = ((uint64_t) probe_stats->count * percent + 99) / 100;
+    uint64_t cumulative = 0;
+    for (uint32_t i = 0; i < PROFILER_HISTOGRAM_BUCKETS; i++) {
+        cumulative += probe_stats->histogram[i];
+        if (cumulative >= target) {
+            // report the upper bound of the bucket, but not above the actual
+            // maximum
+            uint32_t upper = i + 1 < PROFILER_HISTOGRAM_BUCKETS
+                                     ? bucket_lower_bound(i + 1) - 1
+                                     : UINT32_MAX;
+            return ANJ_MIN(upper, probe_stats->max_cycles);
+        }
+    }
+    return probe_stats->max_cycles;
+}
+
+void profiler_reset(profiler_probe_t probe) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    memset(&stats[probe], 0, sizeof(stats[probe]));
+    stats[probe].min_cycles = UINT32_MAX;
+    __set_PRIMASK(primask);
+}
+
+// Anjay Lite drives the handshake with a call per step, each one timed as a
+// sample; the linker redirects the calls here, see CMakeLists.txt
+int __real_mbedtls_ssl_handshake(mbedtls_ssl_context *ssl);
+
+int __wrap_mbedtls_ssl_handshake(mbedtls_ssl_context *ssl) {
+    PROFILER_BEGIN(DTLS_HANDSHAKE);
+    int result = __real_mbedtls_ssl_handshake(ssl);
+    PROFILER_END(DTLS_HANDSHAKE);
+    return result;
+}
+
+// DTLS records are encrypted in mbedtls_ssl_write_record() and decrypted in
+// mbedtls_ssl_read_record(), out of reach of the probes; the linker redirects
+// their calls to the AEAD functions here, see CMakeLists.txt
+int __real_mbedtls_cipher_auth_encrypt_ext(mbedtls_cipher_context_t *ctx,
+                                           const unsigned char *iv,
+                                           size_t iv_len,
+                                           const unsigned char *ad,
+                                           size_t ad_len,
+                                           const unsigned char *input,
+                                           size_t ilen,
+                                           unsigned char *output,
+                                           size_t output_len,
+                                           size_t *olen,
+                                           size_t tag_len);
+
+int __wrap_mbedtls_cipher_auth_encrypt_ext(mbedtls_cipher_context_t *ctx,
+                                           const unsigned char *iv,
+                                           size_t iv_len,
+                                           const unsigned char *ad,
+                                           size_t ad_len,
+                                           const unsigned char *input,
+                                           size_t ilen,
+                                           unsigned char *output,
+                                           size_t output_len,
+                                           size_t *olen,
+                                           size_t tag_len) {
+    PROFILER_BEGIN(DTLS_ENCRYPT);
+    int result = __real_mbedtls_cipher_auth_encrypt_ext(
+            ctx, iv, iv_len, ad, ad_len, input, ilen, output, output_len, olen,
+            tag_len);
+    PROFILER_END(DTLS_ENCRYPT);
+    return result;
+}
+
+int __real_mbedtls_cipher_auth_decrypt_ext(mbedtls_cipher_context_t *ctx,
+                                           const unsigned char *iv,
+                                           size_t iv_len,
+                                           const unsigned char *ad,
+                                           size_t ad_len,
+                                           const unsigned char *input,
+                                           size_t ilen,
+                                           unsigned char *output,
+                                           size_t output_len,
+                                           size_t *olen,
+                                           size_t tag_len);
+
+int __wrap_mbedtls_cipher_auth_decrypt_ext(mbedtls_cipher_context_t *ctx,
+                                           const unsigned char *iv,
+                                           size_t iv_len,
+                                           const unsigned char *ad,
+                                           size_t ad_len,
+                                           const unsigned char *input,
+                                           size_t ilen,
+                                           unsigned char *output,
+                                           size_t output_len,
+                                           size_t *olen,
+                                           size_t tag_len) {
+    PROFILER_BEGIN(DTLS_DECRYPT);
+    int result = __real_mbedtls_cipher_auth_decrypt_ext(
+            ctx, iv, iv_len, ad, ad_len, input, ilen, output, output_len, olen,
+            tag_len);
+    PROFILER_END(DTLS_DECRYPT);
+    return result;
+}
+
+void profiler_log(void) {
+    profiler_log_msg(L_INFO,
+                     "cycles at %" PRIu32 " Hz: min/avg/p50/p90/p99/max",
+                     SystemCoreClock);
+    for (size_t i = 0; i < _PROFILER_PROBE_COUNT; i++) {
+        profiler_stats_t probe_stats;
+        profiler_stats((profiler_probe_t) i, &probe_stats);
+        if (!probe_stats.count) {
+            profiler_log_msg(L_INFO, "%s: no samples", PROBE_NAMES[i]);
+            continue;
+        }
+        profiler_log_msg(
+                L_INFO,
+                "%s: %" PRIu32 "/%" PRIu32 "/%" PRIu32 "/%" PRIu32 "/%" PRIu32
+                "/%" PRIu32 ", %" PRIu32 " samples",
+                PROBE_NAMES[i], probe_stats.min_cycles,
+                (uint32_t) (probe_stats.sum_cycles / probe_stats.count),
+                profiler_percentile(&probe_stats, 50),
+                profiler_percentile(&probe_stats, 90),
+                profiler_percentile(&probe_stats, 99), probe_stats.max_cycles,
+                probe_stats.count);
+    }
+}
+
+#endif // CONFIG_PROFILER
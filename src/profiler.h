@@ -0,0 +1,105 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdint.h>
+
+#include <stm32u3xx.h>
+
+/*
+ * Cycle profiler based on the DWT cycle counter, enabled with CONFIG_PROFILER.
+ * A section of code is measured by enclosing it in probe macros within a
+ * single block:
+ *
+ *     PROFILER_BEGIN(ANJ_CORE_STEP);
+ *     anj_core_step(&anj);
+ *     PROFILER_END(ANJ_CORE_STEP);
+ *
+ * The start timestamp is kept in a local variable, so probes can be used in
+ * interrupt handlers and may nest. Without CONFIG_PROFILER, the macros expand
+ * to nothing.
+ *
+ * NOTE: the cycle counter stops in Sleep and Stop modes, so sections that may
+ * sleep are undercounted; it wraps after ~44 s at 96 MHz.
+ */
+
+typedef enum {
+    PROFILER_PROBE_ANJ_CORE_STEP,
+    PROFILER_PROBE_URC_BUFFER_HANDLER,
+    PROFILER_PROBE_LPUART_ISR,
+    PROFILER_PROBE_DTLS_HANDSHAKE,
+    PROFILER_PROBE_DTLS_ENCRYPT,
+    PROFILER_PROBE_DTLS_DECRYPT,
+    PROFILER_PROBE_READ_SENSORS,
+    _PROFILER_PROBE_COUNT
+} profiler_probe_t;
+
+#ifdef CONFIG_PROFILER
+
+// Cycle counts are bucketed with 4 buckets per power of two, so percentiles
+// are reported with an error below 25%
+#    define PROFILER_HISTOGRAM_BUCKETS 124
+
+typedef struct {
+    uint32_t count;
+    uint32_t min_cycles;
+    uint32_t max_cycles;
+    uint64_t sum_cycles;
+    uint32_t histogram[PROFILER_HISTOGRAM_BUCKETS];
+} profiler_stats_t;
+
+#    define PROFILER_BEGIN(Probe) \
+        const uint32_t Profiler_start_##Probe = DWT->CYCCNT
+
+#    define PROFILER_END(Probe)                       \
+        profiler_record(PROFILER_PROBE_##Probe,       \
+                        DWT->CYCCNT - Profiler_start_##Probe)
+
+/**
+ * Enables the DWT cycle counter. Called before any probe is hit.
+ */
+void profiler_init(void);
+
+/**
+ * Accounts a measurement of @p cycles for @p probe. Safe to call from
+ * interrupt handlers.
+ */
+void profiler_record(profiler_probe_t probe, uint32_t cycles);
+
+const char *profiler_probe_name(profiler_probe_t probe);
+
+/**
+ * Copies the statistics of @p probe, consistently with respect to concurrent
+ * @ref profiler_record calls.
+ */
+void profiler_stats(profiler_probe_t probe, profiler_stats_t *out_stats);
+
+/**
+ * Returns the estimated number of cycles below which @p percent percent of the
+ * measurements fall, or 0 if there are none.
+ */
+uint32_t profiler_percentile(const profiler_stats_t *stats, uint32_t percent);
+
+void profiler_reset(profiler_probe_t probe);
+
+/**
+ * Logs the statistics of all probes, one line per probe.
+ */
+void profiler_log(void);
+
+#else // CONFIG_PROFILER
+
+#    define PROFILER_BEGIN(Probe) ((void) 0)
+#    define PROFILER_END(Probe) ((void) 0)
+
+#endif // CONFIG_PROFILER
+
+#endif // PROFILER_H
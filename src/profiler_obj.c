@@ -0,0 +1,235 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#include <stdint.h>
+
+#include <anj/core.h>
+#include <anj/defs.h>
+#include <anj/dm/core.h>
+#include <anj/utils.h>
+
+#include <stm32u3xx_hal.h>
+
+#include "profiler.h"
+
+#include "profiler_obj.h"
+
+#ifdef CONFIG_PROFILER
+
+// from the range for private objects, which are not registered with OMNA
+#    define PROFILER_OID 32769
+#    define PROFILER_RESOURCES_COUNT 10
+
+enum {
+    RID_PROBE_NAME = 0,
+    RID_SAMPLES = 1,
+    RID_MIN_CYCLES = 2,
+    RID_AVG_CYCLES = 3,
+    RID_MAX_CYCLES = 4,
+    RID_P50_CYCLES = 5,
+    RID_P90_CYCLES = 6,
+    RID_P99_CYCLES = 7,
+    RID_CPU_FREQUENCY = 8,
+    RID_RESET = 9,
+};
+
+enum {
+    RID_PROBE_NAME_IDX = 0,
+    RID_SAMPLES_IDX,
+    RID_MIN_CYCLES_IDX,
+    RID_AVG_CYCLES_IDX,
+    RID_MAX_CYCLES_IDX,
+    RID_P50_CYCLES_IDX,
+    RID_P90_CYCLES_IDX,
+    RID_P99_CYCLES_IDX,
+    RID_CPU_FREQUENCY_IDX,
+    RID_RESET_IDX,
+    _RID_LAST
+};
+
+ANJ_STATIC_ASSERT(_RID_LAST == PROFILER_RESOURCES_COUNT,
+                  profiler_resource_count_mismatch);
+
+static const anj_dm_res_t RES[PROFILER_RESOURCES_COUNT] = {
+    [RID_PROBE_NAME_IDX] = {
+        .rid = RID_PROBE_NAME,
+        .type = ANJ_DATA_TYPE_STRING,
+        .kind = ANJ_DM_RES_R
+    },
+    [RID_SAMPLES_IDX] = {
+        .rid = RID_SAMPLES,
+        .type = ANJ_DATA_TYPE_INT,
+        .kind = ANJ_DM_RES_R
+    },
+    [RID_MIN_CYCLES_IDX] = {
+        .rid = RID_MIN_CYCLES,
+        .type = ANJ_DATA_TYPE_INT,
+        .kind = ANJ_DM_RES_R
+    },
+    [RID_AVG_CYCLES_IDX] = {
+        .rid = RID_AVG_CYCLES,
+        .type = ANJ_DATA_TYPE_INT,
+        .kind = ANJ_DM_RES_R
+    },
+    [RID_MAX_CYCLES_IDX] = {
+        .rid = RID_MAX_CYCLES,
+        .type = ANJ_DATA_TYPE_INT,
+        .kind = ANJ_DM_RES_R
+    },
+    [RID_P50_CYCLES_IDX] = {
+        .rid = RID_P50_CYCLES,
+        .type = ANJ_DATA_TYPE_INT,
+        .kind = ANJ_DM_RES_R
+    },
+    [RID_P90_CYCLES_IDX] = {
+        .rid = RID_P90_CYCLES,
+        .type = ANJ_DATA_TYPE_INT,
+        .kind = ANJ_DM_RES_R
+    },
+    [RID_P99_CYCLES_IDX] = {
+        .rid = RID_P99_CYCLES,
+        .type = ANJ_DATA_TYPE_INT,
+        .kind = ANJ_DM_RES_R
+    },
+    [RID_CPU_FREQUENCY_IDX] = {
+        .rid = RID_CPU_FREQUENCY,
+        .type = ANJ_DATA_TYPE_INT,
+        .kind = ANJ_DM_RES_R
+    },
+    [RID_RESET_IDX] = {
+        .rid = RID_RESET,
+        .kind = ANJ_DM_RES_E
+    }
+};
+
+typedef struct {
+    // reads of the whole instance take a single snapshot, so that all values
+    // are consistent with each other
+    profiler_stats_t snapshot;
+    anj_iid_t snapshot_iid;
+    uint32_t snapshot_tick;
+} profiler_obj_ctx_t;
+
+static profiler_obj_ctx_t profiler_obj_ctx = {
+    .snapshot_iid = ANJ_ID_INVALID
+};
+
+static inline profiler_obj_ctx_t *get_ctx(void) {
+    return &profiler_obj_ctx;
+}
+
+static const profiler_stats_t *get_snapshot(anj_iid_t iid) {
+    profiler_obj_ctx_t *ctx = get_ctx();
+    uint32_t now = HAL_GetTick();
+    if (iid != ctx->snapshot_iid || now != ctx->snapshot_tick) {
+        profiler_stats((profiler_probe_t) iid, &ctx->snapshot);
+        ctx->snapshot_iid = iid;
+        ctx->snapshot_tick = now;
+    }
+    return &ctx->snapshot;
+}
+
+static int res_read(anj_t *anj,
+                    const anj_dm_obj_t *obj,
+                    anj_iid_t iid,
+                    anj_rid_t rid,
+                    anj_riid_t riid,
+                    anj_res_value_t *out_value) {
+    (void) anj;
+    (void) obj;
+    (void) riid;
+
+    if (iid >= _PROFILER_PROBE_COUNT) {
+        return ANJ_DM_ERR_NOT_FOUND;
+    }
+    const profiler_stats_t *stats = get_snapshot(iid);
+    switch (rid) {
+    case RID_PROBE_NAME:
+        out_value->bytes_or_string.data =
+                profiler_probe_name((profiler_probe_t) iid);
+        break;
+    case RID_SAMPLES:
+        out_value->int_value = stats->count;
+        break;
+    case RID_MIN_CYCLES:
+        out_value->int_value = stats->count ? stats->min_cycles : 0;
+        break;
+    case RID_AVG_CYCLES:
+        out_value->int_value =
+                stats->count ? (int64_t) (stats->sum_cycles / stats->count)
+                             : 0;
+        break;
+    case RID_MAX_CYCLES:
+        out_value->int_value = stats->max_cycles;
+        break;
+    case RID_P50_CYCLES:
+        out_value->int_value = profiler_percentile(stats, 50);
+        break;
+    case RID_P90_CYCLES:
+        out_value->int_value = profiler_percentile(stats, 90);
+        break;
+    case RID_P99_CYCLES:
+        out_value->int_value = profiler_percentile(stats, 99);
+        break;
+    case RID_CPU_FREQUENCY:
+        out_value->int_value = SystemCoreClock;
+        break;
+    default:
+        return ANJ_DM_ERR_NOT_FOUND;
+    }
+    return 0;
+}
+
+static int res_execute(anj_t *anj,
+                       const anj_dm_obj_t *obj,
+                       anj_iid_t iid,
+                       anj_rid_t rid,
+                       const char *execute_arg,
+                       size_t execute_arg_len) {
+    (void) anj;
+    (void) obj;
+    (void) execute_arg;
+    (void) execute_arg_len;
+
+    if (iid >= _PROFILER_PROBE_COUNT || rid != RID_RESET) {
+        return ANJ_DM_ERR_NOT_FOUND;
+    }
+    profiler_reset((profiler_probe_t) iid);
+    get_ctx()->snapshot_iid = ANJ_ID_INVALID;
+    return 0;
+}
+
+static const anj_dm_handlers_t PROFILER_OBJ_HANDLERS = {
+    .res_read = res_read,
+    .res_execute = res_execute,
+};
+
+// one instance per probe, with the probe number as the Instance ID
+static anj_dm_obj_inst_t insts[_PROFILER_PROBE_COUNT];
+
+static const anj_dm_obj_t OBJ = {
+    .oid = PROFILER_OID,
+    .version = "1.0",
+    .insts = insts,
+    .handlers = &PROFILER_OBJ_HANDLERS,
+    .max_inst_count = _PROFILER_PROBE_COUNT
+};
+
+const anj_dm_obj_t *profiler_obj_init(void) {
+    for (anj_iid_t i = 0; i < _PROFILER_PROBE_COUNT; i++) {
+        insts[i] = (anj_dm_obj_inst_t) {
+            .iid = i,
+            .res_count = PROFILER_RESOURCES_COUNT,
+            .resources = RES
+        };
+    }
+    return &OBJ;
+}
+
+#endif // CONFIG_PROFILER
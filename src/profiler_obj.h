@@ -0,0 +1,28 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#ifndef _PROFILER_OBJ_H_
+#define _PROFILER_OBJ_H_
+
+#include <anj/core.h>
+#include <anj/defs.h>
+
+#ifdef CONFIG_PROFILER
+
+/**
+ * @brief Returns the Profiler Object (/32769), a private object with one
+ * instance per profiler probe. Resources expose the number of samples and the
+ * min/avg/max and 50th/90th/99th percentile of the cycle counts; executing
+ * resource 9 resets the probe.
+ */
+const anj_dm_obj_t *profiler_obj_init(void);
+
+#endif // CONFIG_PROFILER
+
+#endif // _PROFILER_OBJ_H_
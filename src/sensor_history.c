@@ -0,0 +1,233 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <anj/core.h>
+#include <anj/defs.h>
+#include <anj/log.h>
+#include <anj/lwm2m_send.h>
+#include <anj/utils.h>
+
+#include "sensor_history.h"
+
+#define history_log(...) anj_log(history, __VA_ARGS__)
+
+// samples are taken on a schedule of their own, and may come a bit early
+#define HISTORY_PERIOD_TOLERANCE_MS 500
+// samples are sent at least this often, even if they don't fill a message
+#define HISTORY_MAX_AGE_MS (5 * 60 * 1000)
+
+// resolution of the stored samples
+#define TIME_UNIT_MS 100
+#define VALUE_UNITS_PER_ONE 1000
+
+// Worst case size of a SenML CBOR record: map header, name of up to
+// "/65535/65535/65535", time and value encoded as doubles
+#define SENML_CBOR_RECORD_MAX_SIZE (1 + (1 + 1 + 18) + (1 + 9) + (1 + 9))
+#define SENML_CBOR_ARRAY_HEADER_MAX_SIZE 3
+
+// as many records as fit in the payload of a single message
+#define HISTORY_MAX_RECORDS                                            \
+    ((ANJ_OUT_PAYLOAD_BUFFER_SIZE - SENML_CBOR_ARRAY_HEADER_MAX_SIZE) \
+     / SENML_CBOR_RECORD_MAX_SIZE)
+// the ring takes another message worth of samples while one is being sent
+#define HISTORY_CAPACITY (2 * HISTORY_MAX_RECORDS)
+
+ANJ_STATIC_ASSERT(HISTORY_MAX_RECORDS >= 12, sensor_history_payload_too_small);
+
+typedef struct {
+    // time since the previous sample, in TIME_UNIT_MS
+    uint16_t time_delta;
+    // change since the previous sample, in 1 / VALUE_UNITS_PER_ONE
+    int16_t value_delta;
+} history_entry_t;
+
+#ifdef CONFIG_SENSOR_HISTORY_IN_RAM2
+// NOTE: .ram2 is not initialized at startup, only entries that have been
+// written are read
+#    define HISTORY_SECTION __attribute__((section(".ram2")))
+#else // CONFIG_SENSOR_HISTORY_IN_RAM2
+#    define HISTORY_SECTION
+#endif // CONFIG_SENSOR_HISTORY_IN_RAM2
+
+static history_entry_t entries[HISTORY_CAPACITY] HISTORY_SECTION;
+
+typedef struct {
+    anj_uri_path_t path;
+    size_t first;
+    size_t count;
+    // time and value of the oldest entry, whose deltas are unused
+    uint64_t first_time;
+    int32_t first_value;
+    // time and value of the newest entry, as decoded from the deltas, so that
+    // rounding errors don't accumulate
+    uint64_t last_time;
+    int32_t last_value;
+    // false until the first sample, last_time is valid afterwards even if the
+    // ring has been emptied
+    bool started;
+    // samples taken out of the ring, kept until the server confirms them
+    anj_io_out_entry_t records[HISTORY_MAX_RECORDS];
+    size_t records_count;
+    // time the relative timestamps of the records refer to
+    uint64_t records_time;
+    bool send_in_progress;
+} history_ctx_t;
+
+static history_ctx_t history;
+
+void sensor_history_init(const anj_uri_path_t *path) {
+    history = (history_ctx_t) {
+        .path = *path
+    };
+}
+
+static void drop_first(history_ctx_t *ctx) {
+    size_t next = (ctx->first + 1) % HISTORY_CAPACITY;
+    ctx->first_time += entries[next].time_delta;
+    ctx->first_value += entries[next].value_delta;
+    ctx->first = next;
+    ctx->count--;
+}
+
+// Moves the oldest samples to the records, with timestamps relative to @p now
+static void take_records(history_ctx_t *ctx, uint64_t now) {
+    size_t count = ANJ_MIN(ctx->count, (size_t) HISTORY_MAX_RECORDS);
+    for (size_t i = 0; i < count; i++) {
+        ctx->records[i] = (anj_io_out_entry_t) {
+            .path = ctx->path,
+            .type = ANJ_DATA_TYPE_DOUBLE,
+            .value.double_value =
+                    (double) ctx->first_value / VALUE_UNITS_PER_ONE,
+            .timestamp = -(double) ((now - ctx->first_time) * TIME_UNIT_MS)
+                         / 1000
+        };
+        if (ctx->count > 1) {
+            drop_first(ctx);
+        } else {
+            ctx->count = 0;
+        }
+    }
+    ctx->records_count = count;
+    ctx->records_time = now;
+}
+
+static void append(history_ctx_t *ctx, uint64_t time, int32_t value) {
+    if (ctx->count) {
+        uint64_t time_delta = time - ctx->last_time;
+        int32_t value_delta = value - ctx->last_value;
+        if (time_delta > UINT16_MAX || value_delta < INT16_MIN
+                || value_delta > INT16_MAX) {
+            // NOTE: the sample becomes the new base of the ring, so the ones
+            // before it are moved to the records, to go out with the next
+            // Send, unless the records are still taken by an unconfirmed one
+            if (!ctx->records_count) {
+                take_records(ctx, time);
+            }
+            if (ctx->count) {
+                history_log(L_WARNING,
+                            "sample can't be delta-encoded, dropping %u "
+                            "samples",
+                            (unsigned) ctx->count);
+                ctx->count = 0;
+            }
+        } else {
+            if (ctx->count == HISTORY_CAPACITY) {
+                drop_first(ctx);
+            }
+            entries[(ctx->first + ctx->count) % HISTORY_CAPACITY] =
+                    (history_entry_t) {
+                        .time_delta = (uint16_t) time_delta,
+                        .value_delta = (int16_t) value_delta
+                    };
+            ctx->count++;
+            ctx->last_time += time_delta;
+            ctx->last_value += value_delta;
+            return;
+        }
+    }
+    entries[ctx->first] = (history_entry_t) { 0 };
+    ctx->count = 1;
+    ctx->first_time = ctx->last_time = time;
+    ctx->first_value = ctx->last_value = value;
+}
+
+static void send_finished(anj_t *anj,
+                          uint16_t send_id,
+                          int result,
+                          void *data) {
+    (void) anj;
+    (void) send_id;
+    history_ctx_t *ctx = (history_ctx_t *) data;
+    ctx->send_in_progress = false;
+    if (result == ANJ_SEND_SUCCESS) {
+        ctx->records_count = 0;
+    } else {
+        history_log(L_WARNING, "Send of %u samples failed: %d, will retry",
+                    (unsigned) ctx->records_count, result);
+    }
+}
+
+static void send_records(anj_t *anj, history_ctx_t *ctx, uint64_t now) {
+    // timestamps of records kept for a retry are moved to the new send time
+    double elapsed_s = (double) ((now - ctx->records_time) * TIME_UNIT_MS)
+                       / 1000;
+    for (size_t i = 0; i < ctx->records_count; i++) {
+        ctx->records[i].timestamp -= elapsed_s;
+    }
+    ctx->records_time = now;
+
+    const anj_send_request_t request = {
+        .finished_handler = send_finished,
+        .data = ctx,
+        .content_format = ANJ_COAP_FORMAT_SENML_CBOR,
+        .records_cnt = ctx->records_count,
+        .records = ctx->records
+    };
+    uint16_t send_id;
+    int result = anj_send_new_request(anj, &request, &send_id);
+    if (result) {
+        // e.g. not registered yet; retried with the next sample
+        history_log(L_DEBUG, "Send of %u samples not queued: %d",
+                    (unsigned) ctx->records_count, result);
+        return;
+    }
+    ctx->send_in_progress = true;
+    history_log(L_INFO, "sending %u samples", (unsigned) ctx->records_count);
+}
+
+void sensor_history_add(anj_t *anj, uint64_t timestamp_us, double value) {
+    history_ctx_t *ctx = &history;
+    uint64_t time = timestamp_us / (TIME_UNIT_MS * 1000);
+    uint64_t min_delta =
+            (SENSOR_HISTORY_PERIOD_MS - HISTORY_PERIOD_TOLERANCE_MS)
+            / TIME_UNIT_MS;
+    if (ctx->started && time - ctx->last_time < min_delta) {
+        return;
+    }
+    ctx->started = true;
+    append(ctx, time, (int32_t) lround(value * VALUE_UNITS_PER_ONE));
+
+    if (ctx->send_in_progress) {
+        return;
+    }
+    if (!ctx->records_count
+            && (ctx->count >= HISTORY_MAX_RECORDS
+                || time - ctx->first_time
+                           >= HISTORY_MAX_AGE_MS / TIME_UNIT_MS)) {
+        take_records(ctx, time);
+    }
+    if (ctx->records_count) {
+        send_records(anj, ctx, time);
+    }
+}
@@ -0,0 +1,48 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#ifndef SENSOR_HISTORY_H
+#define SENSOR_HISTORY_H
+
+#include <stdint.h>
+
+#include <anj/core.h>
+#include <anj/defs.h>
+
+/*
+ * History of a sensor value, uploaded in batches with the LwM2M Send
+ * operation, so that a single message carries dozens of timestamped samples
+ * instead of waking the radio up for each of them.
+ *
+ * Samples are kept in a ring as 4-byte deltas from the previous sample, with
+ * 100 ms and 0.001 unit resolution. They are sent as SenML CBOR records once
+ * there are as many as fit in a single message, or once the oldest one gets
+ * too old. Timestamps are relative to the time of sending (negative SenML
+ * times), as the device has no real time clock.
+ */
+
+// one sample is kept every 10 seconds
+#define SENSOR_HISTORY_PERIOD_MS 10000
+
+/**
+ * Starts collecting the history of the resource at @p path.
+ */
+void sensor_history_init(const anj_uri_path_t *path);
+
+/**
+ * Records @p value, measured at @p timestamp_us, as returned by
+ * @ref timebase_now_us. Samples closer than the history period to the previous
+ * one, less a small tolerance for the jitter of the sampling schedule, are
+ * skipped. Requests a Send of the collected samples when needed.
+ *
+ * @param anj Anjay Lite instance the samples are sent with.
+ */
+void sensor_history_add(anj_t *anj, uint64_t timestamp_us, double value);
+
+#endif // SENSOR_HISTORY_H
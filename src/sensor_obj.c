@@ -0,0 +1,840 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <anj/core.h>
+#include <anj/defs.h>
+#include <anj/dm/core.h>
+#include <anj/log.h>
+#include <anj/utils.h>
+
+#include <stm32u3xx_hal.h>
+#include <stm32u3xx_ll_adc.h>
+
+#include "adc_scan.h"
+#include "compat/observe_compat.h"
+#include "profiler.h"
+#include "sensor_history.h"
+#include "temp_calibration.h"
+#include "timebase.h"
+
+#include "sensor_obj.h"
+
+#define sensor_log(...) anj_log(sensor_obj, __VA_ARGS__)
+
+enum {
+    RID_ANALOG_INPUT_CURRENT_VALUE = 5600,
+    RID_MIN_MEASURED_VALUE = 5601,
+    RID_MAX_MEASURED_VALUE = 5602,
+    RID_RESET_MIN_MAX_MEASURED_VALUES = 5605,
+    RID_SENSOR_VALUE = 5700,
+    RID_SENSOR_UNIT = 5701,
+    RID_APPLICATION_TYPE = 5750,
+};
+
+// resources of the Temperature and Voltage objects
+#define SENSOR_RESOURCES_COUNT 6
+
+enum {
+    RID_MIN_MEASURED_VALUE_IDX = 0,
+    RID_MAX_MEASURED_VALUE_IDX,
+    RID_RESET_MIN_MAX_MEASURED_VALUES_IDX,
+    RID_SENSOR_VALUE_IDX,
+    RID_SENSOR_UNIT_IDX,
+    RID_APPLICATION_TYPE_IDX,
+    _RID_LAST
+};
+
+ANJ_STATIC_ASSERT(_RID_LAST == SENSOR_RESOURCES_COUNT,
+                  sensor_resource_count_mismatch);
+
+static const anj_dm_res_t SENSOR_RES[SENSOR_RESOURCES_COUNT] = {
+    [RID_MIN_MEASURED_VALUE_IDX] = {
+        .rid = RID_MIN_MEASURED_VALUE,
+        .type = ANJ_DATA_TYPE_DOUBLE,
+        .kind = ANJ_DM_RES_R
+    },
+    [RID_MAX_MEASURED_VALUE_IDX] = {
+        .rid = RID_MAX_MEASURED_VALUE,
+        .type = ANJ_DATA_TYPE_DOUBLE,
+        .kind = ANJ_DM_RES_R
+    },
+    [RID_RESET_MIN_MAX_MEASURED_VALUES_IDX] = {
+        .rid = RID_RESET_MIN_MAX_MEASURED_VALUES,
+        .kind = ANJ_DM_RES_E
+    },
+    [RID_SENSOR_VALUE_IDX] = {
+        .rid = RID_SENSOR_VALUE,
+        .type = ANJ_DATA_TYPE_DOUBLE,
+        .kind = ANJ_DM_RES_R
+    },
+    [RID_SENSOR_UNIT_IDX] = {
+        .rid = RID_SENSOR_UNIT,
+        .type = ANJ_DATA_TYPE_STRING,
+        .kind = ANJ_DM_RES_R
+    },
+    [RID_APPLICATION_TYPE_IDX] = {
+        .rid = RID_APPLICATION_TYPE,
+        .type = ANJ_DATA_TYPE_STRING,
+        .kind = ANJ_DM_RES_RW
+    }
+};
+
+// resources of the Analog Input object
+#define ANALOG_INPUT_RESOURCES_COUNT 5
+
+enum {
+    AI_RID_ANALOG_INPUT_CURRENT_VALUE_IDX = 0,
+    AI_RID_MIN_MEASURED_VALUE_IDX,
+    AI_RID_MAX_MEASURED_VALUE_IDX,
+    AI_RID_RESET_MIN_MAX_MEASURED_VALUES_IDX,
+    AI_RID_APPLICATION_TYPE_IDX,
+    _AI_RID_LAST
+};
+
+ANJ_STATIC_ASSERT(_AI_RID_LAST == ANALOG_INPUT_RESOURCES_COUNT,
+                  analog_input_resource_count_mismatch);
+
+static const anj_dm_res_t ANALOG_INPUT_RES[ANALOG_INPUT_RESOURCES_COUNT] = {
+    [AI_RID_ANALOG_INPUT_CURRENT_VALUE_IDX] = {
+        .rid = RID_ANALOG_INPUT_CURRENT_VALUE,
+        .type = ANJ_DATA_TYPE_DOUBLE,
+        .kind = ANJ_DM_RES_R
+    },
+    [AI_RID_MIN_MEASURED_VALUE_IDX] = {
+        .rid = RID_MIN_MEASURED_VALUE,
+        .type = ANJ_DATA_TYPE_DOUBLE,
+        .kind = ANJ_DM_RES_R
+    },
+    [AI_RID_MAX_MEASURED_VALUE_IDX] = {
+        .rid = RID_MAX_MEASURED_VALUE,
+        .type = ANJ_DATA_TYPE_DOUBLE,
+        .kind = ANJ_DM_RES_R
+    },
+    [AI_RID_RESET_MIN_MAX_MEASURED_VALUES_IDX] = {
+        .rid = RID_RESET_MIN_MAX_MEASURED_VALUES,
+        .kind = ANJ_DM_RES_E
+    },
+    [AI_RID_APPLICATION_TYPE_IDX] = {
+        .rid = RID_APPLICATION_TYPE,
+        .type = ANJ_DATA_TYPE_STRING,
+        .kind = ANJ_DM_RES_RW
+    }
+};
+
+typedef enum {
+    SENSOR_KIND_ANALOG_INPUT,
+    SENSOR_KIND_TEMPERATURE,
+    SENSOR_KIND_VOLTAGE,
+    _SENSOR_KIND_COUNT
+} sensor_kind_t;
+
+typedef struct {
+    anj_oid_t oid;
+    const char *version;
+    // resource the sensor value is read from, and its attributes taken from
+    anj_rid_t value_rid;
+    const anj_dm_res_t *resources;
+    uint16_t res_count;
+} sensor_kind_def_t;
+
+static const sensor_kind_def_t KINDS[] = {
+    [SENSOR_KIND_ANALOG_INPUT] = {
+        .oid = 3202,
+        .version = "1.1",
+        .value_rid = RID_ANALOG_INPUT_CURRENT_VALUE,
+        .resources = ANALOG_INPUT_RES,
+        .res_count = ANALOG_INPUT_RESOURCES_COUNT
+    },
+    [SENSOR_KIND_TEMPERATURE] = {
+        .oid = 3303,
+        .version = "1.1",
+        .value_rid = RID_SENSOR_VALUE,
+        .resources = SENSOR_RES,
+        .res_count = SENSOR_RESOURCES_COUNT
+    },
+    [SENSOR_KIND_VOLTAGE] = {
+        .oid = 3316,
+        .version = "1.1",
+        .value_rid = RID_SENSOR_VALUE,
+        .resources = SENSOR_RES,
+        .res_count = SENSOR_RESOURCES_COUNT
+    }
+};
+
+ANJ_STATIC_ASSERT(ANJ_ARRAY_SIZE(KINDS) == _SENSOR_KIND_COUNT,
+                  sensor_kinds_mismatch);
+
+#define SENSOR_APPL_TYPE_MAX_SIZE 32
+
+#ifdef CONFIG_TEMP_ALARM_LOW
+#    define TEMP_ALARM_LOW CONFIG_TEMP_ALARM_LOW
+#else // CONFIG_TEMP_ALARM_LOW
+#    define TEMP_ALARM_LOW NAN
+#endif // CONFIG_TEMP_ALARM_LOW
+#ifdef CONFIG_TEMP_ALARM_HIGH
+#    define TEMP_ALARM_HIGH CONFIG_TEMP_ALARM_HIGH
+#else // CONFIG_TEMP_ALARM_HIGH
+#    define TEMP_ALARM_HIGH NAN
+#endif // CONFIG_TEMP_ALARM_HIGH
+
+typedef struct {
+    sensor_kind_t kind;
+    anj_iid_t iid;
+    adc_scan_channel_t channel;
+    // computes the sensor value from the filtered ADC readings
+    double (*read)(void);
+    // inverse of read, in the units of adc_scan_value(); NULL if the sensor
+    // can't be watched with the analog watchdog
+    double (*to_value)(double sensor_value);
+    // NULL for objects without the Sensor Units resource
+    const char *unit;
+    const char *application_type;
+    // used unless the Step attribute is set
+    double deadband;
+    // used unless the Less Than and Greater Than attributes are set; NAN for
+    // none
+    double alarm_low;
+    double alarm_high;
+    // the sensor value is collected by sensor_history, at most one sensor
+    bool history;
+} sensor_def_t;
+
+static double read_temperature(void);
+static double temperature_to_value(double temp);
+static double read_vdda(void);
+static double read_vbat(void);
+static double vbat_to_value(double vbat);
+#ifdef ADC_SCAN_HAVE_EXT
+static double read_ext(void);
+#endif // ADC_SCAN_HAVE_EXT
+
+/**
+ * All sensors, sorted by kind and Instance ID: the instances of each object
+ * are consecutive entries. Adding a sensor takes an entry here, and a channel
+ * in adc_scan.h if it's not sampled yet.
+ */
+static const sensor_def_t SENSORS[] = {
+#ifdef ADC_SCAN_HAVE_EXT
+    {
+        .kind = SENSOR_KIND_ANALOG_INPUT,
+        .iid = 0,
+        .channel = ADC_SCAN_EXT,
+        .read = read_ext,
+        .to_value = adc_scan_voltage_to_value,
+        .application_type = "Analog_1",
+        .deadband = 0.01,
+        .alarm_low = NAN,
+        .alarm_high = NAN
+    },
+#endif // ADC_SCAN_HAVE_EXT
+    {
+        .kind = SENSOR_KIND_TEMPERATURE,
+        .iid = 0,
+        .channel = ADC_SCAN_TEMPSENSOR,
+        .read = read_temperature,
+        .to_value = temperature_to_value,
+        .unit = "C",
+        .application_type = "Sensor_1",
+        .deadband = 0.1,
+        .alarm_low = TEMP_ALARM_LOW,
+        .alarm_high = TEMP_ALARM_HIGH,
+        .history = true
+    },
+    {
+        // analog supply, computed from the internal reference
+        .kind = SENSOR_KIND_VOLTAGE,
+        .iid = 0,
+        .channel = ADC_SCAN_VREFINT,
+        .read = read_vdda,
+        .unit = "V",
+        .application_type = "VDDA",
+        .deadband = 0.01,
+        .alarm_low = NAN,
+        .alarm_high = NAN
+    },
+    {
+        .kind = SENSOR_KIND_VOLTAGE,
+        .iid = 1,
+        .channel = ADC_SCAN_VBAT,
+        .read = read_vbat,
+        .to_value = vbat_to_value,
+        .unit = "V",
+        .application_type = "VBAT",
+        .deadband = 0.01,
+        .alarm_low = NAN,
+        .alarm_high = NAN
+    },
+};
+
+#define SENSOR_COUNT ANJ_ARRAY_SIZE(SENSORS)
+
+/**
+ * Changes of a sensor value are signalled to Anjay Lite only once they exceed
+ * the deadband, and not more often than the minimum report interval. Both are
+ * taken from the Step and Minimum Period attributes of the sensor value when
+ * the server has set them. Changes of the min/max values are signalled
+ * together with the sensor value.
+ */
+#define SENSOR_OBJ_DEFAULT_MIN_REPORT_INTERVAL_MS 5000
+
+/**
+ * The ADC is powered down between bursts of conversions, which sample all
+ * sensors at once. While any sensor value is observed, bursts are scheduled at
+ * its minimum report interval, bounded by the limits below; otherwise only as
+ * often as the history needs them. Reads of a sensor value take a fresh sample
+ * when the latest one is older than SENSOR_OBJ_MAX_SAMPLE_AGE_MS.
+ *
+ * Between bursts, if any Greater Than or Less Than threshold is set, the ADC
+ * is not powered down but keeps watching that sensor with its analog watchdog.
+ * A reading beyond the thresholds nearest to the sensor value wakes the CPU up
+ * and makes the main loop take a sample, which is then reported as usual,
+ * without waiting for the next scheduled one. When the server sets no
+ * thresholds, the alarm band of the sensor table is used, if any.
+ */
+#define SENSOR_OBJ_MIN_SAMPLING_PERIOD_MS 1000
+#define SENSOR_OBJ_MAX_SAMPLING_PERIOD_MS SENSOR_HISTORY_PERIOD_MS
+#define SENSOR_OBJ_MAX_SAMPLE_AGE_MS 1000
+
+typedef struct {
+    double deadband;
+    bool has_greater_than;
+    double greater_than;
+    bool has_less_than;
+    double less_than;
+    uint32_t min_report_interval_ms;
+} sensor_report_policy_t;
+
+typedef enum {
+    SENSOR_CHANGED_VALUE = 1 << 0,
+    SENSOR_CHANGED_MIN = 1 << 1,
+    SENSOR_CHANGED_MAX = 1 << 2,
+} sensor_changed_t;
+
+typedef struct {
+    double value;
+    double min_value;
+    double max_value;
+    char application_type[SENSOR_APPL_TYPE_MAX_SIZE];
+    char application_type_cached[SENSOR_APPL_TYPE_MAX_SIZE];
+    // sensor value at the time of the last signalled change
+    double reported_value;
+    uint32_t reported_tick;
+    // sensor_changed_t flags not signalled yet
+    uint8_t pending_changes;
+    // as of the latest scheduled sample
+    sensor_report_policy_t policy;
+} sensor_ctx_t;
+
+static sensor_ctx_t sensor_ctx[SENSOR_COUNT];
+static uint64_t next_sample_time_us;
+
+static anj_uri_path_t value_path(size_t sensor) {
+    const sensor_def_t *def = &SENSORS[sensor];
+    return ANJ_MAKE_RESOURCE_PATH(KINDS[def->kind].oid, def->iid,
+                                  KINDS[def->kind].value_rid);
+}
+
+static int find_sensor(anj_oid_t oid, anj_iid_t iid) {
+    for (size_t i = 0; i < SENSOR_COUNT; i++) {
+        if (KINDS[SENSORS[i].kind].oid == oid && SENSORS[i].iid == iid) {
+            return (int) i;
+        }
+    }
+    return -1;
+}
+
+static bool is_observed(anj_t *anj, size_t sensor) {
+#ifdef ANJ_WITH_OBSERVE
+    const anj_uri_path_t path = value_path(sensor);
+    return observe_compat_is_observed(anj, &path);
+#else  // ANJ_WITH_OBSERVE
+    (void) anj;
+    (void) sensor;
+    return false;
+#endif // ANJ_WITH_OBSERVE
+}
+
+static void get_report_policy(anj_t *anj,
+                              size_t sensor,
+                              sensor_report_policy_t *out_policy) {
+    const sensor_def_t *def = &SENSORS[sensor];
+    *out_policy = (sensor_report_policy_t) {
+        .deadband = def->deadband,
+        .min_report_interval_ms = SENSOR_OBJ_DEFAULT_MIN_REPORT_INTERVAL_MS
+    };
+#ifdef ANJ_WITH_OBSERVE
+    const anj_uri_path_t path = value_path(sensor);
+    observe_compat_attrs_t attrs;
+    observe_compat_get_attrs(anj, &path, &attrs);
+    if (attrs.has_step) {
+        out_policy->deadband = attrs.step;
+    } else if (attrs.has_greater_than || attrs.has_less_than) {
+        // with thresholds but no step, the server is only interested in
+        // crossings
+        out_policy->deadband = INFINITY;
+    }
+    out_policy->has_greater_than = attrs.has_greater_than;
+    out_policy->greater_than = attrs.greater_than;
+    out_policy->has_less_than = attrs.has_less_than;
+    out_policy->less_than = attrs.less_than;
+    if (attrs.has_min_period) {
+        out_policy->min_report_interval_ms = attrs.min_period * 1000;
+    }
+#else  // ANJ_WITH_OBSERVE
+    (void) anj;
+#endif // ANJ_WITH_OBSERVE
+    if (!out_policy->has_greater_than && !isnan(def->alarm_high)) {
+        out_policy->has_greater_than = true;
+        out_policy->greater_than = def->alarm_high;
+    }
+    if (!out_policy->has_less_than && !isnan(def->alarm_low)) {
+        out_policy->has_less_than = true;
+        out_policy->less_than = def->alarm_low;
+    }
+}
+
+static bool crossed(double threshold, double prev_value, double value) {
+    return (prev_value > threshold) != (value > threshold);
+}
+
+static void signal_changes(anj_t *anj, size_t sensor, uint8_t changes) {
+    const sensor_def_t *def = &SENSORS[sensor];
+    // in the order of sensor_changed_t flags
+    const anj_rid_t rids[] = {
+        KINDS[def->kind].value_rid, RID_MIN_MEASURED_VALUE,
+        RID_MAX_MEASURED_VALUE
+    };
+    for (size_t i = 0; i < ANJ_ARRAY_SIZE(rids); i++) {
+        if (changes & (1 << i)) {
+            anj_core_data_model_changed(
+                    anj,
+                    &ANJ_MAKE_RESOURCE_PATH(KINDS[def->kind].oid, def->iid,
+                                            rids[i]),
+                    ANJ_CORE_CHANGE_TYPE_VALUE_CHANGED);
+        }
+    }
+}
+
+// Updates the sensor values and the min/max values from a completed burst
+static bool finish_sampling(void) {
+    PROFILER_BEGIN(READ_SENSORS);
+    bool sampled = adc_scan_finish();
+    for (size_t i = 0; sampled && i < SENSOR_COUNT; i++) {
+        sensor_ctx_t *ctx = &sensor_ctx[i];
+        ctx->value = SENSORS[i].read();
+        if (ctx->value < ctx->min_value) {
+            ctx->min_value = ctx->value;
+            ctx->pending_changes |= SENSOR_CHANGED_MIN;
+        }
+        if (ctx->value > ctx->max_value) {
+            ctx->max_value = ctx->value;
+            ctx->pending_changes |= SENSOR_CHANGED_MAX;
+        }
+    }
+    PROFILER_END(READ_SENSORS);
+    return sampled;
+}
+
+// Finds the thresholds nearest to @p value on both sides, infinite if there
+// are none on that side
+static bool get_alarm_window(const sensor_report_policy_t *policy,
+                             double value,
+                             double *out_low,
+                             double *out_high) {
+    const struct {
+        bool set;
+        double threshold;
+    } thresholds[] = {
+        { policy->has_greater_than, policy->greater_than },
+        { policy->has_less_than, policy->less_than }
+    };
+    bool found = false;
+    *out_low = -INFINITY;
+    *out_high = INFINITY;
+    for (size_t i = 0; i < ANJ_ARRAY_SIZE(thresholds); i++) {
+        if (!thresholds[i].set) {
+            continue;
+        }
+        found = true;
+        // same as in crossed(), a value equal to the threshold is below it
+        if (thresholds[i].threshold >= value) {
+            *out_high = fmin(*out_high, thresholds[i].threshold);
+        } else {
+            *out_low = fmax(*out_low, thresholds[i].threshold);
+        }
+    }
+    return found;
+}
+
+// Leaves the ADC watching for a crossing of the thresholds nearest to the
+// value of the first sensor that has any, or powers it down
+static void watch_or_power_down(void) {
+    for (size_t i = 0; i < SENSOR_COUNT; i++) {
+        const sensor_def_t *def = &SENSORS[i];
+        double low;
+        double high;
+        if (!def->to_value
+                || !get_alarm_window(&sensor_ctx[i].policy,
+                                     sensor_ctx[i].value, &low, &high)) {
+            continue;
+        }
+        // NOTE: there's a single analog watchdog; thresholds of the other
+        // sensors are only checked by the scheduled samples
+        double value_a = def->to_value(low);
+        double value_b = def->to_value(high);
+        adc_scan_watch(def->channel, fmin(value_a, value_b),
+                       fmax(value_a, value_b));
+        return;
+    }
+    adc_scan_power_down();
+}
+
+// Takes a sample synchronously, or completes the burst already in progress
+static bool acquire_sample(void) {
+    if (!adc_scan_in_progress()) {
+        adc_scan_start();
+    }
+    while (!adc_scan_ready()) {
+        __WFI();
+    }
+    bool sampled = finish_sampling();
+    watch_or_power_down();
+    return sampled;
+}
+
+static uint32_t sampling_period_ms(anj_t *anj) {
+    uint32_t period_ms = SENSOR_OBJ_MAX_SAMPLING_PERIOD_MS;
+    for (size_t i = 0; i < SENSOR_COUNT; i++) {
+        // sampling faster than the reports may go out would be wasted
+        if (is_observed(anj, i)) {
+            period_ms = ANJ_MIN(
+                    period_ms,
+                    ANJ_MAX(sensor_ctx[i].policy.min_report_interval_ms,
+                            (uint32_t) SENSOR_OBJ_MIN_SAMPLING_PERIOD_MS));
+        }
+    }
+    return period_ms;
+}
+
+static bool report_changes(anj_t *anj, size_t sensor) {
+    sensor_ctx_t *ctx = &sensor_ctx[sensor];
+    const sensor_report_policy_t *policy = &ctx->policy;
+    if (fabs(ctx->value - ctx->reported_value) >= policy->deadband
+            || (policy->has_greater_than
+                && crossed(policy->greater_than, ctx->reported_value,
+                           ctx->value))
+            || (policy->has_less_than
+                && crossed(policy->less_than, ctx->reported_value,
+                           ctx->value))) {
+        ctx->pending_changes |= SENSOR_CHANGED_VALUE;
+    }
+
+    // min/max changes wait for a significant change of the sensor value, they
+    // are never further from the truth than the deadband
+    uint32_t now = HAL_GetTick();
+    if (!(ctx->pending_changes & SENSOR_CHANGED_VALUE)
+            || now - ctx->reported_tick < policy->min_report_interval_ms) {
+        return false;
+    }
+    signal_changes(anj, sensor, ctx->pending_changes);
+    ctx->pending_changes = 0;
+    ctx->reported_value = ctx->value;
+    ctx->reported_tick = now;
+    return true;
+}
+
+bool sensor_obj_update(anj_t *anj) {
+    if (!adc_scan_in_progress()) {
+        if (adc_scan_alarm() || timebase_now_us() >= next_sample_time_us) {
+            adc_scan_start();
+        }
+        return false;
+    }
+    if (!adc_scan_ready()) {
+        return false;
+    }
+    bool sampled = finish_sampling();
+
+    for (size_t i = 0; i < SENSOR_COUNT; i++) {
+        get_report_policy(anj, i, &sensor_ctx[i].policy);
+    }
+    watch_or_power_down();
+    next_sample_time_us =
+            timebase_now_us() + (uint64_t) sampling_period_ms(anj) * 1000;
+    if (!sampled) {
+        return false;
+    }
+
+    bool changed = false;
+    for (size_t i = 0; i < SENSOR_COUNT; i++) {
+        if (SENSORS[i].history) {
+            sensor_history_add(anj, adc_scan_time_us(), sensor_ctx[i].value);
+        }
+        changed = report_changes(anj, i) || changed;
+    }
+    return changed;
+}
+
+uint64_t sensor_obj_deadline_us(void) {
+    // NOTE: the end of a burst and crossings of the thresholds are signalled
+    // by interrupts, which wake the loop up before these deadlines
+    if (adc_scan_in_progress()) {
+        return adc_scan_deadline_us();
+    }
+    return next_sample_time_us;
+}
+
+static int res_read(anj_t *anj,
+                    const anj_dm_obj_t *obj,
+                    anj_iid_t iid,
+                    anj_rid_t rid,
+                    anj_riid_t riid,
+                    anj_res_value_t *out_value) {
+    (void) anj;
+    (void) riid;
+
+    int sensor = find_sensor(obj->oid, iid);
+    if (sensor < 0) {
+        return ANJ_DM_ERR_NOT_FOUND;
+    }
+    sensor_ctx_t *ctx = &sensor_ctx[sensor];
+
+    switch (rid) {
+    case RID_ANALOG_INPUT_CURRENT_VALUE:
+    case RID_SENSOR_VALUE:
+        if (timebase_now_us() - adc_scan_time_us()
+                >= SENSOR_OBJ_MAX_SAMPLE_AGE_MS * 1000ULL) {
+            // on failure, the previous value is served
+            acquire_sample();
+        }
+        out_value->double_value = ctx->value;
+        break;
+    case RID_MIN_MEASURED_VALUE:
+        out_value->double_value = ctx->min_value;
+        break;
+    case RID_MAX_MEASURED_VALUE:
+        out_value->double_value = ctx->max_value;
+        break;
+    case RID_SENSOR_UNIT:
+        out_value->bytes_or_string.data = SENSORS[sensor].unit;
+        break;
+    case RID_APPLICATION_TYPE:
+        out_value->bytes_or_string.data = ctx->application_type;
+        break;
+    default:
+        return ANJ_DM_ERR_NOT_FOUND;
+    }
+    return 0;
+}
+
+static int res_write(anj_t *anj,
+                     const anj_dm_obj_t *obj,
+                     anj_iid_t iid,
+                     anj_rid_t rid,
+                     anj_riid_t riid,
+                     const anj_res_value_t *value) {
+    (void) anj;
+    (void) riid;
+
+    int sensor = find_sensor(obj->oid, iid);
+    if (sensor < 0) {
+        return ANJ_DM_ERR_NOT_FOUND;
+    }
+
+    switch (rid) {
+    case RID_APPLICATION_TYPE:
+        return anj_dm_write_string_chunked(
+                value, sensor_ctx[sensor].application_type,
+                SENSOR_APPL_TYPE_MAX_SIZE, NULL);
+    default:
+        return ANJ_DM_ERR_NOT_FOUND;
+    }
+    return 0;
+}
+
+static int res_execute(anj_t *anj,
+                       const anj_dm_obj_t *obj,
+                       anj_iid_t iid,
+                       anj_rid_t rid,
+                       const char *execute_arg,
+                       size_t execute_arg_len) {
+    (void) execute_arg;
+    (void) execute_arg_len;
+
+    int sensor = find_sensor(obj->oid, iid);
+    if (sensor < 0) {
+        return ANJ_DM_ERR_NOT_FOUND;
+    }
+    sensor_ctx_t *ctx = &sensor_ctx[sensor];
+
+    switch (rid) {
+    case RID_RESET_MIN_MAX_MEASURED_VALUES: {
+        ctx->min_value = ctx->value;
+        ctx->max_value = ctx->value;
+        ctx->pending_changes &=
+                (uint8_t) ~(SENSOR_CHANGED_MIN | SENSOR_CHANGED_MAX);
+        signal_changes(anj, (size_t) sensor,
+                       SENSOR_CHANGED_MIN | SENSOR_CHANGED_MAX);
+        break;
+    }
+    default:
+        return ANJ_DM_ERR_NOT_FOUND;
+    }
+
+    return 0;
+}
+
+static int transaction_begin(anj_t *anj, const anj_dm_obj_t *obj) {
+    (void) anj;
+    for (size_t i = 0; i < SENSOR_COUNT; i++) {
+        if (KINDS[SENSORS[i].kind].oid == obj->oid) {
+            memcpy(sensor_ctx[i].application_type_cached,
+                   sensor_ctx[i].application_type, SENSOR_APPL_TYPE_MAX_SIZE);
+        }
+    }
+    return 0;
+}
+
+static void transaction_end(anj_t *anj,
+                            const anj_dm_obj_t *obj,
+                            anj_dm_transaction_result_t result) {
+    (void) anj;
+    if (!result) {
+        return;
+    }
+    // Restore cached data
+    for (size_t i = 0; i < SENSOR_COUNT; i++) {
+        if (KINDS[SENSORS[i].kind].oid == obj->oid) {
+            memcpy(sensor_ctx[i].application_type,
+                   sensor_ctx[i].application_type_cached,
+                   SENSOR_APPL_TYPE_MAX_SIZE);
+        }
+    }
+}
+
+static const anj_dm_handlers_t SENSOR_OBJ_HANDLERS = {
+    .res_read = res_read,
+    .res_write = res_write,
+    .res_execute = res_execute,
+    .transaction_begin = transaction_begin,
+    .transaction_end = transaction_end,
+};
+
+// instances of each object are consecutive, in the order of SENSORS
+static anj_dm_obj_inst_t insts[SENSOR_COUNT];
+static anj_dm_obj_t objs[_SENSOR_KIND_COUNT];
+
+static void calibration_init(void);
+
+int sensor_obj_install(anj_t *anj) {
+    calibration_init();
+    adc_scan_init();
+
+    // the first sample starts the filter and the min/max values
+    acquire_sample();
+    uint32_t now = HAL_GetTick();
+    for (size_t i = 0; i < SENSOR_COUNT; i++) {
+        sensor_ctx_t *ctx = &sensor_ctx[i];
+        strncpy(ctx->application_type, SENSORS[i].application_type,
+                SENSOR_APPL_TYPE_MAX_SIZE - 1);
+        ctx->min_value = ctx->value;
+        ctx->max_value = ctx->value;
+        ctx->reported_value = ctx->value;
+        ctx->reported_tick = now;
+        ctx->pending_changes = 0;
+        if (SENSORS[i].history) {
+            const anj_uri_path_t path = value_path(i);
+            sensor_history_init(&path);
+        }
+    }
+    next_sample_time_us = timebase_now_us();
+
+    for (size_t i = 0; i < SENSOR_COUNT;) {
+        const sensor_kind_t kind = SENSORS[i].kind;
+        size_t first = i;
+        for (; i < SENSOR_COUNT && SENSORS[i].kind == kind; i++) {
+            insts[i] = (anj_dm_obj_inst_t) {
+                .iid = SENSORS[i].iid,
+                .res_count = KINDS[kind].res_count,
+                .resources = KINDS[kind].resources
+            };
+        }
+        objs[kind] = (anj_dm_obj_t) {
+            .oid = KINDS[kind].oid,
+            .version = KINDS[kind].version,
+            .insts = &insts[first],
+            .handlers = &SENSOR_OBJ_HANDLERS,
+            .max_inst_count = (uint16_t) (i - first)
+        };
+        int result = anj_dm_add_obj(anj, &objs[kind]);
+        if (result) {
+            sensor_log(L_ERROR, "Failed to install object /%u: %d",
+                       (unsigned) KINDS[kind].oid, result);
+            return result;
+        }
+    }
+    return 0;
+}
+
+// NOTE: the calibration data is only valid if both the sensor and the internal
+// reference were calibrated at the same Vref+, see temp_calibration.c
+ANJ_STATIC_ASSERT(TEMPSENSOR_CAL_VREF == VREFINT_CAL_VREF,
+                  calibration_vref_mismatch);
+
+static temp_calibration_t calibration;
+
+static void calibration_init(void) {
+    const temp_calibration_data_t data = {
+        .cal1_temp = TEMPSENSOR_CAL1_TEMP,
+        .cal2_temp = TEMPSENSOR_CAL2_TEMP,
+        .cal1_value = *TEMPSENSOR_CAL1_ADDR,
+        .cal2_value = *TEMPSENSOR_CAL2_ADDR,
+        .vrefint_cal = *VREFINT_CAL_ADDR
+    };
+    temp_calibration_init(&calibration, &data);
+}
+
+static double read_temperature(void) {
+    int32_t temp_q16 = temp_calibration_convert(
+            &calibration, adc_scan_value(ADC_SCAN_TEMPSENSOR),
+            adc_scan_value(ADC_SCAN_VREFINT));
+    return (float) temp_q16 * (1.0f / 65536);
+}
+
+static double temperature_to_value(double temp) {
+    return temp_calibration_to_raw(&calibration, temp,
+                                   adc_scan_value(ADC_SCAN_VREFINT));
+}
+
+static double read_vdda(void) {
+    return adc_scan_vdda();
+}
+
+// VBAT is measured through a 1/4 divider
+#define VBAT_DIVIDER 4
+
+static double read_vbat(void) {
+    return VBAT_DIVIDER * adc_scan_voltage(ADC_SCAN_VBAT);
+}
+
+static double vbat_to_value(double vbat) {
+    return adc_scan_voltage_to_value(vbat / VBAT_DIVIDER);
+}
+
+#ifdef ADC_SCAN_HAVE_EXT
+static double read_ext(void) {
+    return adc_scan_voltage(ADC_SCAN_EXT);
+}
+#endif // ADC_SCAN_HAVE_EXT
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#ifndef SENSOR_OBJ_H
+#define SENSOR_OBJ_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <anj/core.h>
+#include <anj/defs.h>
+
+/*
+ * IPSO sensor objects fed by the ADC: Temperature (/3303) from the internal
+ * temperature sensor, Voltage (/3316) with the analog supply and the backup
+ * battery voltages, and Analog Input (/3202) from an external pin, when one is
+ * configured. Sensors are described by a table, so that all of them share the
+ * sampling schedule, the read and notification path and the handlers.
+ */
+
+/**
+ * @brief Calibrates the ADC, takes the first sample of all sensors as their
+ * current min and max values, powers the ADC down until the next one and
+ * installs the objects.
+ *
+ * @param anj Anjay Lite instance to install the objects in.
+ *
+ * @returns 0 on success, a negative value if any object couldn't be installed.
+ */
+int sensor_obj_install(anj_t *anj);
+
+/**
+ * @brief Updates the sensor values and adjusts min/max tracked values.
+ *
+ * All sensors are sampled together, in bursts of ADC conversions started and
+ * completed by this function, which is meant to be called on every iteration
+ * of the main loop, at least by @ref sensor_obj_deadline_us. Bursts are
+ * scheduled at the shortest minimum report interval of the observed sensor
+ * values, and at the history period when none is observed. When the ADC
+ * analog watchdog detects a crossing of a Greater Than or Less Than threshold,
+ * a burst is started right away.
+ *
+ * Changes of each sensor are signalled to Anjay Lite in batches, once its
+ * value moves by more than a deadband or crosses a threshold, and not more
+ * often than its minimum report interval. Deadband, thresholds and interval
+ * follow the Step, Greater Than, Less Than and Minimum Period attributes of
+ * the sensor value when they are set.
+ *
+ * @param anj Anjay Lite instance the objects are installed in.
+ *
+ * @returns true if a change of any sensor value has been signalled.
+ */
+bool sensor_obj_update(anj_t *anj);
+
+/**
+ * @brief Returns the time, as returned by @ref timebase_now_us, by which
+ * @ref sensor_obj_update has to be called again.
+ */
+uint64_t sensor_obj_deadline_us(void);
+
+#endif // SENSOR_OBJ_H
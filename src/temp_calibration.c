@@ -0,0 +1,72 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#include <stdint.h>
+
+#include "temp_calibration.h"
+
+/**
+ * Both the sensor and the internal reference were calibrated at the same Vref+,
+ * so the analog supply voltage cancels out and the temperature is a linear
+ * function of the ratio of the two readings:
+ *
+ *   T = CAL1_TEMP + (CAL2_TEMP - CAL1_TEMP) / (CAL2_VALUE - CAL1_VALUE)
+ *                   * (VREFINT_CAL * temp_raw / vref_raw - CAL1_VALUE)
+ *     = offset + slope * temp_raw / vref_raw
+ *
+ * The oversampling scale cancels out as well, so the filtered values are used
+ * as they are. Offset and slope are computed once from the calibration data;
+ * slope / vref_raw is only recomputed when the filtered reference reading
+ * changes, which leaves a 64-bit multiply, a shift and an add per conversion.
+ *
+ * tests/temp_calibration_test.c checks the result against the exact value of
+ * the formula above for every 12-bit sensor reading, over the whole range of
+ * reference readings and oversampling scales: it's within 0.00002 C, i.e. the
+ * 1/2^16 C resolution of the result, while the same computation done in single
+ * precision floating point is off by up to 0.0005 C.
+ * tests/temp_calibration_bench.c compares the speed of the two on the host.
+ */
+
+void temp_calibration_init(temp_calibration_t *cal,
+                           const temp_calibration_data_t *data) {
+    int32_t cal_delta = (int32_t) data->cal2_value - (int32_t) data->cal1_value;
+    int64_t temp_delta = data->cal2_temp - data->cal1_temp;
+
+    *cal = (temp_calibration_t) {
+        .slope_q30 = (temp_delta * (int64_t) data->vrefint_cal << 30)
+                     / cal_delta,
+        .offset_q16 = (int32_t) (((int64_t) data->cal1_temp << 16)
+                                 - ((temp_delta * data->cal1_value << 16)
+                                    / cal_delta))
+    };
+}
+
+int32_t temp_calibration_convert(temp_calibration_t *cal,
+                                 uint32_t temp_raw,
+                                 uint32_t vref_raw) {
+    if (vref_raw && vref_raw != cal->gain_vref_raw) {
+        // NOTE: oversampled readings are up to 2^10 times larger, and the
+        // gain that many times smaller, so it's kept in 64 bits not to lose
+        // precision; the product below stays within 2^58 for sensor readings
+        // up to three times the reference one, well above what it can read
+        cal->gain_q46 = (cal->slope_q30 << 16) / (int64_t) vref_raw;
+        cal->gain_vref_raw = vref_raw;
+    }
+    return cal->offset_q16
+           + (int32_t) ((cal->gain_q46 * (int64_t) temp_raw) >> 30);
+}
+
+double temp_calibration_to_raw(const temp_calibration_t *cal,
+                               double temp,
+                               uint32_t vref_raw) {
+    // the thresholds are only computed when they move, so there's no need for
+    // fixed point here
+    return (temp - (double) cal->offset_q16 / (1 << 16)) * vref_raw
+           * (double) (1 << 30) / (double) cal->slope_q30;
+}
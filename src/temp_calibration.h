@@ -0,0 +1,69 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#ifndef TEMP_CALIBRATION_H
+#define TEMP_CALIBRATION_H
+
+#include <stdint.h>
+
+/*
+ * Fixed point conversion of the internal temperature sensor readings, based on
+ * the factory calibration data. Kept apart from sensor_obj.c, which reads the
+ * calibration data and the ADC, so that it can be verified on the host, see
+ * tests/temp_calibration_test.c.
+ */
+
+typedef struct {
+    int32_t cal1_temp;
+    int32_t cal2_temp;
+    // sensor readings at the above temperatures
+    uint16_t cal1_value;
+    uint16_t cal2_value;
+    // internal reference reading; all three were taken at the same Vref+
+    uint16_t vrefint_cal;
+} temp_calibration_data_t;
+
+typedef struct {
+    // in 1/2^16 C
+    int32_t offset_q16;
+    // in 1/2^30 C
+    int64_t slope_q30;
+    // slope / gain_vref_raw in 1/2^46 C; 0 until the first non-zero reference
+    // reading
+    int64_t gain_q46;
+    uint32_t gain_vref_raw;
+} temp_calibration_t;
+
+void temp_calibration_init(temp_calibration_t *cal,
+                           const temp_calibration_data_t *data);
+
+/**
+ * Converts a sensor reading to temperature. Both readings have to be scaled
+ * the same way, e.g. by the same oversampling settings.
+ *
+ * @param cal      Calibration, the cached gain is updated if @p vref_raw has
+ *                 changed since the last call.
+ * @param temp_raw Sensor reading.
+ * @param vref_raw Internal reference reading; if 0, i.e. not sampled yet, the
+ *                 last gain is used.
+ *
+ * @returns Temperature in 1/2^16 C.
+ */
+int32_t temp_calibration_convert(temp_calibration_t *cal,
+                                 uint32_t temp_raw,
+                                 uint32_t vref_raw);
+
+/**
+ * Inverse of @ref temp_calibration_convert, in floating point.
+ */
+double temp_calibration_to_raw(const temp_calibration_t *cal,
+                               double temp,
+                               uint32_t vref_raw);
+
+#endif // TEMP_CALIBRATION_H
@@ -0,0 +1,212 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <stm32u3xx_hal.h>
+#include <stm32u3xx_ll_lptim.h>
+#include <stm32u3xx_ll_pwr.h>
+#include <stm32u3xx_ll_rcc.h>
+
+#include "timebase.h"
+
+// LPTIM1 runs from LSE (or LSI if there's no crystal) without a prescaler,
+// which gives ~30.5 us resolution; the 16-bit counter wraps every 2 seconds and
+// the wraps are counted in software
+#define TIMEBASE_LPTIM LPTIM1
+#define TIMEBASE_PERIOD_TICKS 0x10000U
+#define TIMEBASE_ARR (TIMEBASE_PERIOD_TICKS - 1)
+
+// LSE typically starts within 200-400 ms, but may take up to 2 s with some
+// crystals; this is the number of readiness checks before falling back to LSI
+#define TIMEBASE_LSE_READY_ATTEMPTS 4000000U
+
+// a compare closer than this may already be missed by the time the write to
+// the compare register completes
+#define TIMEBASE_MIN_WAKEUP_TICKS 4U
+
+// NOTE: writes to LPTIM registers are synchronized to the kernel clock, so they
+// take a few 32 kHz cycles to complete; they're only done during init and when
+// the wakeup compare is reprogrammed
+#define TIMEBASE_WAIT_FOR(Flag)                                 \
+    do {                                                        \
+        while (!LL_LPTIM_IsActiveFlag_##Flag(TIMEBASE_LPTIM)) { \
+        }                                                       \
+        LL_LPTIM_ClearFlag_##Flag(TIMEBASE_LPTIM);              \
+    } while (0)
+
+static bool initialized;
+static uint32_t tick_freq_hz = LSE_VALUE;
+// number of times the LPTIM counter has wrapped around, i.e. the upper bits of
+// the 64-bit tick counter
+static volatile uint64_t overflows;
+
+// The counter is clocked asynchronously to the bus, so a single read may return
+// a value in transition; two consecutive equal reads are reliable
+static uint32_t read_counter(void) {
+    uint32_t cnt;
+    do {
+        cnt = LL_LPTIM_GetCounter(TIMEBASE_LPTIM);
+    } while (cnt != LL_LPTIM_GetCounter(TIMEBASE_LPTIM));
+    return cnt;
+}
+
+static uint64_t read_ticks(void) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint64_t ovf = overflows;
+    uint32_t cnt = read_counter();
+    if (LL_LPTIM_IsActiveFlag_ARRM(TIMEBASE_LPTIM)) {
+        // the counter has reached ARR, but the interrupt did not run yet, e.g.
+        // because we're called from a higher priority ISR; the flag is set
+        // while the counter still holds ARR, so it only counts as a wrap once
+        // the counter went back to the beginning of the period
+        cnt = read_counter();
+        if (cnt < TIMEBASE_PERIOD_TICKS / 2) {
+            ovf++;
+        }
+    }
+    __set_PRIMASK(primask);
+    return ovf * TIMEBASE_PERIOD_TICKS + cnt;
+}
+
+void LPTIM1_IRQHandler(void) {
+    if (LL_LPTIM_IsActiveFlag_ARRM(TIMEBASE_LPTIM)) {
+        // wait for the counter to leave ARR, so that readers never see an
+        // incremented overflow count together with the value from before the
+        // wrap; this takes at most one LPTIM cycle
+        while (read_counter() == TIMEBASE_ARR) {
+        }
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        LL_LPTIM_ClearFlag_ARRM(TIMEBASE_LPTIM);
+        overflows++;
+        __set_PRIMASK(primask);
+    }
+    if (LL_LPTIM_IsActiveFlag_CC1(TIMEBASE_LPTIM)) {
+        // the compare only exists to wake the CPU up
+        LL_LPTIM_ClearFlag_CC1(TIMEBASE_LPTIM);
+    }
+}
+
+static uint32_t start_low_speed_clock(void) {
+    LL_PWR_EnableBkUpAccess();
+    if (!LL_RCC_LSE_IsReady()) {
+        LL_RCC_LSE_Enable();
+        for (uint32_t i = 0;
+             i < TIMEBASE_LSE_READY_ATTEMPTS && !LL_RCC_LSE_IsReady();
+             i++) {
+        }
+    }
+    if (LL_RCC_LSE_IsReady()) {
+        LL_RCC_SetLPTIMClockSource(LL_RCC_LPTIM1_CLKSOURCE_LSE);
+        return LSE_VALUE;
+    }
+    LL_RCC_LSI_Enable();
+    while (!LL_RCC_LSI_IsReady()) {
+    }
+    LL_RCC_SetLPTIMClockSource(LL_RCC_LPTIM1_CLKSOURCE_LSI);
+    return LSI_VALUE;
+}
+
+// Overrides the weak HAL implementation, which configures SysTick. Called from
+// HAL_Init() and again on every system clock change; LPTIM1 does not depend on
+// the system clock, so it's only configured once.
+HAL_StatusTypeDef HAL_InitTick(uint32_t TickPriority) {
+    if (TickPriority >= (1UL << __NVIC_PRIO_BITS)) {
+        return HAL_ERROR;
+    }
+    HAL_NVIC_SetPriority(LPTIM1_IRQn, TickPriority, 0);
+    uwTickPrio = TickPriority;
+    if (initialized) {
+        return HAL_OK;
+    }
+
+    __HAL_RCC_PWR_CLK_ENABLE();
+    tick_freq_hz = start_low_speed_clock();
+    __HAL_RCC_LPTIM1_CLK_ENABLE();
+    __HAL_RCC_LPTIM1_CLK_SLEEP_ENABLE();
+
+    // clock source and prescaler may only be changed while disabled, the
+    // remaining registers only while enabled
+    LL_LPTIM_SetClockSource(TIMEBASE_LPTIM, LL_LPTIM_CLK_SOURCE_INTERNAL);
+    LL_LPTIM_SetPrescaler(TIMEBASE_LPTIM, LL_LPTIM_PRESCALER_DIV1);
+    LL_LPTIM_Enable(TIMEBASE_LPTIM);
+    LL_LPTIM_EnableIT_ARRM(TIMEBASE_LPTIM);
+    LL_LPTIM_EnableIT_CC1(TIMEBASE_LPTIM);
+    TIMEBASE_WAIT_FOR(DIEROK);
+    LL_LPTIM_SetAutoReload(TIMEBASE_LPTIM, TIMEBASE_ARR);
+    TIMEBASE_WAIT_FOR(ARROK);
+    LL_LPTIM_OC_SetCompareCH1(TIMEBASE_LPTIM, TIMEBASE_ARR);
+    TIMEBASE_WAIT_FOR(CMP1OK);
+    LL_LPTIM_CC_EnableChannel(TIMEBASE_LPTIM, LL_LPTIM_CHANNEL_CH1);
+    LL_LPTIM_StartCounter(TIMEBASE_LPTIM, LL_LPTIM_OPERATING_MODE_CONTINUOUS);
+
+    // SysTick is not used at all, so it does not wake the CPU up every 1 ms
+    SysTick->CTRL = 0;
+    HAL_NVIC_EnableIRQ(LPTIM1_IRQn);
+    initialized = true;
+    return HAL_OK;
+}
+
+// Overrides the weak HAL implementation, which reads uwTick. The value wraps
+// after ~49 days, just like the original one.
+uint32_t HAL_GetTick(void) {
+    return (uint32_t) timebase_now_ms();
+}
+
+// Overrides the weak HAL implementation, which busy-waits on uwTick
+void HAL_Delay(uint32_t Delay) {
+    uint64_t deadline = timebase_now_us() + (uint64_t) Delay * 1000;
+    while (timebase_now_us() < deadline) {
+        timebase_set_wakeup(deadline);
+        __WFI();
+    }
+}
+
+// The LPTIM keeps counting in Sleep and Stop modes, there's nothing to suspend
+void HAL_SuspendTick(void) {}
+
+void HAL_ResumeTick(void) {}
+
+static uint64_t ticks_to_us(uint64_t ticks) {
+    return ticks / tick_freq_hz * 1000000
+           + ticks % tick_freq_hz * 1000000 / tick_freq_hz;
+}
+
+uint64_t timebase_now_us(void) {
+    return ticks_to_us(read_ticks());
+}
+
+uint64_t timebase_now_ms(void) {
+    return timebase_now_us() / 1000;
+}
+
+void timebase_set_wakeup(uint64_t deadline_us) {
+    uint64_t now_ticks = read_ticks();
+    uint64_t now_us = ticks_to_us(now_ticks);
+    if (deadline_us <= now_us) {
+        return;
+    }
+    uint64_t delta_ticks =
+            (deadline_us - now_us) * tick_freq_hz / 1000000 + 1;
+    if (delta_ticks >= TIMEBASE_PERIOD_TICKS) {
+        // the overflow interrupt fires before the deadline anyway; the caller
+        // reprograms the wakeup after each one
+        return;
+    }
+    if (delta_ticks < TIMEBASE_MIN_WAKEUP_TICKS) {
+        delta_ticks = TIMEBASE_MIN_WAKEUP_TICKS;
+    }
+    uint32_t compare =
+            (uint32_t) ((now_ticks + delta_ticks) % TIMEBASE_PERIOD_TICKS);
+    LL_LPTIM_OC_SetCompareCH1(TIMEBASE_LPTIM, compare);
+    TIMEBASE_WAIT_FOR(CMP1OK);
+}
@@ -0,0 +1,50 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#ifndef TIMEBASE_H
+#define TIMEBASE_H
+
+#include <stdint.h>
+
+/*
+ * Tickless time base on LPTIM1, clocked from LSE (LSI if LSE fails to start).
+ * It replaces the 1 kHz SysTick as the HAL time base, i.e. HAL_InitTick(),
+ * HAL_GetTick() and HAL_Delay() are implemented on top of it, and keeps
+ * counting in Sleep and Stop modes. The resolution is one LPTIM cycle,
+ * ~30.5 us.
+ */
+
+/**
+ * Returns the time since boot in microseconds. The 16-bit LPTIM counter is
+ * extended to 64 bits, so the value does not wrap during the lifetime of the
+ * device.
+ *
+ * Safe to call from both thread and interrupt context, including with
+ * interrupts disabled.
+ */
+uint64_t timebase_now_us(void);
+
+/**
+ * Same as @ref timebase_now_us, in milliseconds.
+ */
+uint64_t timebase_now_ms(void);
+
+/**
+ * Programs a one-shot LPTIM compare, so that the CPU is woken up from WFI or
+ * Stop mode no later than at @p deadline_us. The CPU is also woken up every
+ * LPTIM period (2 s), when the counter wraps, and deadlines further than that
+ * are left to the caller to program again after such a wakeup.
+ *
+ * Deadlines in the past are ignored. Only one deadline is held at a time.
+ *
+ * @param deadline_us Absolute time, as returned by @ref timebase_now_us.
+ */
+void timebase_set_wakeup(uint64_t deadline_us);
+
+#endif // TIMEBASE_H
@@ -0,0 +1,48 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <platform.h>
+#include <stm32u3xx_hal.h>
+
+#include "host_hal.h"
+
+// Host stand-ins for the HAL functions called by the code under test
+
+// HAL_Delay() only moves the tick forward instead of sleeping, as nothing
+// simulated on the host needs the time to pass
+static uint32_t delayed_ms;
+
+HASH_TypeDef host_hash;
+HASH_DIGEST_TypeDef host_hash_digest;
+
+__attribute__((weak)) void host_hal_poll(void) {}
+
+uint32_t HAL_GetTick(void) {
+    host_hal_poll();
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t) ((uint64_t) now.tv_sec * 1000
+                       + (uint64_t) now.tv_nsec / 1000000)
+           + delayed_ms;
+}
+
+void HAL_Delay(uint32_t delay_ms) {
+    host_hal_poll();
+    delayed_ms += delay_ms;
+}
+
+void Error_Handler(void) {
+    fprintf(stderr, "Error_Handler() called\n");
+    abort();
+}
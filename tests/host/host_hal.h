@@ -0,0 +1,21 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#ifndef HOST_HAL_H
+#define HOST_HAL_H
+
+/**
+ * Called on every HAL_GetTick() and HAL_Delay(), which the code under test
+ * does in all of its wait loops. Does nothing by default; a test that
+ * simulates a peripheral overrides it to run the "interrupts" of that
+ * peripheral.
+ */
+void host_hal_poll(void);
+
+#endif // HOST_HAL_H
@@ -0,0 +1,17 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#include <stdio.h>
+
+#include <anj/compat/log_impl_decls.h>
+
+// Host counterpart of src/compat/log.c
+void anj_log_handler_output(const char *output, size_t len) {
+    fprintf(stderr, "%.*s\n", (int) len, output);
+}
@@ -0,0 +1,16 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+/*
+ * Added to the mbed TLS configuration of the application in the host builds,
+ * see src/compat/mbedtls/anj_client_mbedtls_config.h
+ */
+
+// for tests/mbedtls_selftest.c
+#define MBEDTLS_SELF_TEST
@@ -0,0 +1,19 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#ifndef PLATFORM_H
+#define PLATFORM_H
+
+// Host stand-in for the CubeMX header, see stm32u3xx_hal.h
+
+#include "stm32u3xx_hal.h"
+
+void Error_Handler(void);
+
+#endif // PLATFORM_H
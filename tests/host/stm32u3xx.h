@@ -0,0 +1,70 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#ifndef STM32U3XX_H
+#define STM32U3XX_H
+
+// Host stand-in for the device header, see stm32u3xx_hal.h
+
+#include <stdint.h>
+
+// simulated interrupts are run synchronously, so there's nothing to mask
+static inline uint32_t __get_PRIMASK(void) {
+    return 0;
+}
+
+static inline void __set_PRIMASK(uint32_t priMask) {
+    (void) priMask;
+}
+
+static inline void __disable_irq(void) {}
+
+static inline uint32_t __REV(uint32_t value) {
+    return __builtin_bswap32(value);
+}
+
+// peripherals with no registers accessed directly by the code under test
+typedef struct {
+    uint32_t unused;
+} AES_TypeDef;
+
+#define AES ((AES_TypeDef *) 0)
+
+typedef struct {
+    volatile uint32_t CR;
+    volatile uint32_t DIN;
+    volatile uint32_t STR;
+    volatile uint32_t HR[5];
+    volatile uint32_t IMR;
+    volatile uint32_t SR;
+    volatile uint32_t CSR[54];
+} HASH_TypeDef;
+
+typedef struct {
+    volatile uint32_t HR[8];
+} HASH_DIGEST_TypeDef;
+
+// registers of the HASH peripheral, in host/hal.c; nothing sets its status
+// flags, so waiting for them times out
+extern HASH_TypeDef host_hash;
+extern HASH_DIGEST_TypeDef host_hash_digest;
+
+#define HASH (&host_hash)
+#define HASH_DIGEST (&host_hash_digest)
+
+#define HASH_CR_INIT (1UL << 2)
+#define HASH_CR_DATATYPE_1 (1UL << 5)
+#define HASH_CR_ALGO_0 (1UL << 17)
+#define HASH_CR_ALGO_1 (1UL << 18)
+#define HASH_STR_DCAL (1UL << 8)
+#define HASH_SR_DINIS (1UL << 0)
+#define HASH_SR_DCIS (1UL << 1)
+#define HASH_SR_BUSY (1UL << 3)
+
+#endif // STM32U3XX_H
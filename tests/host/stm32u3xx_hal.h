@@ -0,0 +1,81 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#ifndef STM32U3XX_HAL_H
+#define STM32U3XX_HAL_H
+
+/*
+ * Host stand-in for the HAL header, declaring only what the code built in
+ * tests/ uses. The CMSIS headers can't be used instead, as their intrinsics
+ * are ARM assembly.
+ */
+
+#include <stdint.h>
+
+#include "stm32u3xx.h"
+
+typedef enum {
+    HAL_OK = 0x00,
+    HAL_ERROR = 0x01,
+    HAL_BUSY = 0x02,
+    HAL_TIMEOUT = 0x03
+} HAL_StatusTypeDef;
+
+typedef struct {
+    int instance;
+} UART_HandleTypeDef;
+
+uint32_t HAL_GetTick(void);
+void HAL_Delay(uint32_t Delay);
+
+HAL_StatusTypeDef
+HAL_UART_Transmit_IT(UART_HandleTypeDef *huart, const uint8_t *pData,
+                     uint16_t Size);
+HAL_StatusTypeDef
+HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UART_AbortReceive(UART_HandleTypeDef *huart);
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart);
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart);
+
+typedef struct {
+    uint32_t DataType;
+    uint32_t KeySize;
+    uint32_t *pKey;
+    uint32_t Algorithm;
+    uint32_t DataWidthUnit;
+    uint32_t KeyIVConfigSkip;
+} CRYP_ConfigTypeDef;
+
+typedef struct {
+    AES_TypeDef *Instance;
+    CRYP_ConfigTypeDef Init;
+} CRYP_HandleTypeDef;
+
+#define CRYP_BYTE_SWAP 0x2
+#define CRYP_KEYSIZE_128B 0x0
+#define CRYP_KEYSIZE_256B 0x1
+#define CRYP_AES_ECB 0x0
+#define CRYP_DATAWIDTHUNIT_BYTE 0x1
+#define CRYP_KEYIVCONFIG_ONCE 0x1
+
+HAL_StatusTypeDef HAL_CRYP_Init(CRYP_HandleTypeDef *hcryp);
+HAL_StatusTypeDef HAL_CRYP_SetConfig(CRYP_HandleTypeDef *hcryp,
+                                     CRYP_ConfigTypeDef *pConf);
+HAL_StatusTypeDef HAL_CRYP_Encrypt(CRYP_HandleTypeDef *hcryp,
+                                   uint32_t *Input,
+                                   uint16_t Size,
+                                   uint32_t *Output,
+                                   uint32_t Timeout);
+
+#define __HAL_RCC_AES_CLK_ENABLE() ((void) 0)
+#define __HAL_RCC_HASH_CLK_ENABLE() ((void) 0)
+#define __HAL_RCC_LPUART1_CLK_ENABLE() ((void) 0)
+#define __HAL_RCC_LPUART1_CLK_DISABLE() ((void) 0)
+
+#endif // STM32U3XX_HAL_H
@@ -0,0 +1,19 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#ifndef USART_H
+#define USART_H
+
+// Host stand-in for the CubeMX header, see stm32u3xx_hal.h
+
+#include "stm32u3xx_hal.h"
+
+extern UART_HandleTypeDef hlpuart1;
+
+#endif // USART_H
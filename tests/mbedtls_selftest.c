@@ -0,0 +1,77 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+/*
+ * Runs the known-answer self-tests of mbed TLS for the primitives DTLS is built
+ * on, with the configuration of the application.
+ *
+ * Built with CONFIG_MBEDTLS_HW_AES and CONFIG_MBEDTLS_HW_SHA256, aes_alt.c and
+ * sha256_alt.c are used, in front of stand-ins for the peripherals: the AES
+ * one hands back the plaintext, and the HASH one never completes. The
+ * self-tests then only pass if both notice, and fall back to the software
+ * implementation.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <mbedtls/aes.h>
+#include <mbedtls/ccm.h>
+#include <mbedtls/sha256.h>
+
+#include <stm32u3xx_hal.h>
+
+static unsigned crypt_calls;
+
+HAL_StatusTypeDef HAL_CRYP_Init(CRYP_HandleTypeDef *hcryp) {
+    (void) hcryp;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_CRYP_SetConfig(CRYP_HandleTypeDef *hcryp,
+                                     CRYP_ConfigTypeDef *pConf) {
+    (void) hcryp;
+    (void) pConf;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_CRYP_Encrypt(CRYP_HandleTypeDef *hcryp,
+                                   uint32_t *Input,
+                                   uint16_t Size,
+                                   uint32_t *Output,
+                                   uint32_t Timeout) {
+    (void) hcryp;
+    (void) Timeout;
+    crypt_calls++;
+    memmove(Output, Input, Size);
+    return HAL_OK;
+}
+
+int main(void) {
+    if (mbedtls_aes_self_test(1) || mbedtls_ccm_self_test(1)
+            || mbedtls_sha256_self_test(1)) {
+        return EXIT_FAILURE;
+    }
+#ifdef CONFIG_MBEDTLS_HW_AES
+    // the peripheral has to be tried before falling back
+    if (!crypt_calls) {
+        fprintf(stderr, "AES peripheral not used\n");
+        return EXIT_FAILURE;
+    }
+#endif // CONFIG_MBEDTLS_HW_AES
+#ifdef CONFIG_MBEDTLS_HW_SHA256
+    if (!HASH->CR) {
+        fprintf(stderr, "HASH peripheral not used\n");
+        return EXIT_FAILURE;
+    }
+#endif // CONFIG_MBEDTLS_HW_SHA256
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,251 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+/*
+ * Runs the modem driver built with CONFIG_NET_NIDD against a stand-in for the
+ * BG96 AT interface, behind a simulated LPUART. The stand-in acknowledges
+ * every command, checks the hex-encoded payload of AT+CSODCP and sends each
+ * payload back in a +CRTDCP URC, like a loopback server would.
+ *
+ * The simulated UART shifts out a limited number of bytes per poll, so that
+ * the hex payload of large datagrams doesn't fit in the TX buffer at once and
+ * has to be streamed.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <stm32u3xx_hal.h>
+#include <usart.h>
+
+#include "host_hal.h"
+#include "modem/modem.h"
+#include "modem/modem_constants.h"
+
+// bytes shifted out by the UART per host_hal_poll() call
+#define UART_TX_BYTES_PER_POLL 64
+
+#define CHECK(Cond)                                                    \
+    do {                                                               \
+        if (!(Cond)) {                                                 \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__,     \
+                    __LINE__, #Cond);                                  \
+            exit(EXIT_FAILURE);                                        \
+        }                                                              \
+    } while (0)
+
+UART_HandleTypeDef hlpuart1;
+
+static const uint8_t *uart_tx_byte;
+static uint8_t *uart_rx_byte;
+
+// command line being received by the stand-in modem
+static char at_line[2 * MODEM_NIDD_DATA_MAX + 64];
+static size_t at_line_len;
+
+// output of the stand-in modem, not yet received by the driver
+static char modem_out[4 * MODEM_NIDD_DATA_MAX];
+static size_t modem_out_len;
+static size_t modem_out_pos;
+
+// last payload accepted with AT+CSODCP
+static uint8_t sent[MODEM_NIDD_DATA_MAX];
+static size_t sent_len;
+static bool lowercase_urc;
+
+static void modem_write(const char *str) {
+    size_t len = strlen(str);
+    CHECK(modem_out_len + len <= sizeof(modem_out));
+    memcpy(modem_out + modem_out_len, str, len);
+    modem_out_len += len;
+}
+
+static int hex_value(char chr) {
+    const char *digits = "0123456789ABCDEF";
+    const char *found = chr ? strchr(digits, chr) : NULL;
+    return found ? (int) (found - digits) : -1;
+}
+
+static void send_crtdcp(const uint8_t *data, size_t len) {
+    const char *digits =
+            lowercase_urc ? "0123456789abcdef" : "0123456789ABCDEF";
+    char header[32];
+    snprintf(header, sizeof(header), "\r\n+CRTDCP: 1,%zu,\"", len);
+    modem_write(header);
+    for (size_t i = 0; i < len; i++) {
+        char hex[3] = { digits[data[i] >> 4], digits[data[i] & 0x0F], '\0' };
+        modem_write(hex);
+    }
+    modem_write("\"\r\n");
+}
+
+// AT+CSODCP=<cid>,<cpdata_length>,"<cpdata>"
+static bool handle_csodcp(const char *args) {
+    unsigned cid;
+    size_t len;
+    int hex_start;
+    if (sscanf(args, "%u,%zu,\"%n", &cid, &len, &hex_start) != 2
+            || cid != 1 || len > MODEM_NIDD_DATA_MAX
+            || strlen(args + hex_start) != 2 * len + 1
+            || args[hex_start + 2 * len] != '"') {
+        return false;
+    }
+    for (size_t i = 0; i < len; i++) {
+        int high = hex_value(args[hex_start + 2 * i]);
+        int low = hex_value(args[hex_start + 2 * i + 1]);
+        if (high < 0 || low < 0) {
+            return false;
+        }
+        sent[i] = (uint8_t) (high << 4 | low);
+    }
+    sent_len = len;
+    send_crtdcp(sent, sent_len);
+    return true;
+}
+
+static void handle_at_line(void) {
+    at_line[at_line_len] = '\0';
+    bool ok = true;
+    if (!strcmp(at_line, "AT+CREG?")) {
+        modem_write("\r\n+CREG: 0,1\r\n");
+    } else if (!strncmp(at_line, "AT+CSODCP=", strlen("AT+CSODCP="))) {
+        ok = handle_csodcp(at_line + strlen("AT+CSODCP="));
+    } else if (strncmp(at_line, "AT", 2)) {
+        ok = false;
+    }
+    modem_write(ok ? "\r\nOK\r\n" : "\r\nERROR\r\n");
+    at_line_len = 0;
+}
+
+static void modem_read(uint8_t byte) {
+    if (byte == '\r' || byte == '\n') {
+        if (at_line_len) {
+            handle_at_line();
+        }
+        return;
+    }
+    CHECK(at_line_len < sizeof(at_line) - 1);
+    at_line[at_line_len++] = (char) byte;
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit_IT(UART_HandleTypeDef *huart,
+                                       const uint8_t *pData,
+                                       uint16_t Size) {
+    CHECK(huart == &hlpuart1 && Size == 1 && !uart_tx_byte);
+    uart_tx_byte = pData;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef
+HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size) {
+    CHECK(huart == &hlpuart1 && Size == 1);
+    uart_rx_byte = pData;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_AbortReceive(UART_HandleTypeDef *huart) {
+    CHECK(huart == &hlpuart1);
+    uart_rx_byte = NULL;
+    return HAL_OK;
+}
+
+void host_hal_poll(void) {
+    for (int i = 0; i < UART_TX_BYTES_PER_POLL && uart_tx_byte; i++) {
+        uint8_t byte = *uart_tx_byte;
+        uart_tx_byte = NULL;
+        modem_read(byte);
+        HAL_UART_TxCpltCallback(&hlpuart1);
+    }
+    while (modem_out_pos < modem_out_len && uart_rx_byte) {
+        uint8_t *rx_byte = uart_rx_byte;
+        uart_rx_byte = NULL;
+        *rx_byte = (uint8_t) modem_out[modem_out_pos++];
+        HAL_UART_RxCpltCallback(&hlpuart1);
+    }
+    if (modem_out_pos == modem_out_len) {
+        modem_out_pos = modem_out_len = 0;
+    }
+}
+
+static void send_datagram(const uint8_t *data, size_t len) {
+    modem_nidd_send_ctx_t ctx;
+    CHECK(!modem_nidd_send_init(&ctx, data, len));
+    int result;
+    while ((result = modem_nidd_send_continue(&ctx)) > 0) {
+        host_hal_poll();
+    }
+    CHECK(result == 0);
+    CHECK(sent_len == len && !memcmp(sent, data, len));
+}
+
+static void recv_datagram(const uint8_t *expected, size_t len) {
+    uint8_t buf[MODEM_NIDD_DATA_MAX];
+    size_t received;
+    int result;
+    for (int i = 0; (result = modem_socket_try_recv(buf, sizeof(buf),
+                                                    &received))
+                    > 0;
+         i++) {
+        CHECK(i < 1000);
+        host_hal_poll();
+    }
+    CHECK(result == 0);
+    CHECK(received == len && !memcmp(buf, expected, len));
+}
+
+static void expect_no_datagram(void) {
+    uint8_t buf[MODEM_NIDD_DATA_MAX];
+    size_t received;
+    for (int i = 0; i < 100; i++) {
+        host_hal_poll();
+    }
+    CHECK(modem_socket_try_recv(buf, sizeof(buf), &received) == 1);
+}
+
+static void test_loopback(size_t len) {
+    static uint8_t data[MODEM_NIDD_DATA_MAX];
+    for (size_t i = 0; i < len; i++) {
+        data[i] = (uint8_t) (i + len);
+    }
+    send_datagram(data, len);
+    recv_datagram(data, len);
+}
+
+static void test_malformed_urcs(void) {
+    static const uint8_t data[] = { 0x00, 0x7F, 0x80, 0xFF };
+    // invalid hex digit, wrong length, missing quotes
+    modem_write("\r\n+CRTDCP: 1,4,\"007F80FG\"\r\n");
+    modem_write("\r\n+CRTDCP: 1,5,\"007F80FF\"\r\n");
+    modem_write("\r\n+CRTDCP: 1,4,007F80FF\r\n");
+    expect_no_datagram();
+    // nothing from the malformed URCs is left in the receive queue
+    send_crtdcp(data, sizeof(data));
+    recv_datagram(data, sizeof(data));
+}
+
+int main(void) {
+    CHECK(!modem_bringup());
+
+    test_loopback(1);
+    test_loopback(100);
+    // doesn't fit in the TX buffer as hex, so it's streamed
+    test_loopback(MODEM_NIDD_DATA_MAX);
+    lowercase_urc = true;
+    test_loopback(MODEM_NIDD_DATA_MAX);
+    lowercase_urc = false;
+    test_malformed_urcs();
+
+    static const uint8_t too_long[MODEM_NIDD_DATA_MAX + 1];
+    modem_nidd_send_ctx_t ctx;
+    CHECK(modem_nidd_send_init(&ctx, too_long, sizeof(too_long)));
+    return EXIT_SUCCESS;
+}
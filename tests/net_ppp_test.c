@@ -0,0 +1,336 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+/*
+ * Runs net_ppp.c and lwIP against pppd on a pseudo-terminal, which stands in
+ * for the modem in PPP data mode. The host end of the link runs a UDP and a
+ * TCP echo server; the UDP one answers a single datagram with a burst of them
+ * to check that nothing is lost when the link delivers more than one read at
+ * a time.
+ *
+ * pppd has to be run as root, the test is skipped otherwise.
+ */
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <anj/compat/net/anj_net_api.h>
+
+#include <lwip/arch.h>
+#include <lwip/sys.h>
+
+#include "modem/modem.h"
+
+#define SKIP 77
+
+#define HOST_ADDR "10.64.64.1"
+#define CLIENT_ADDR "10.64.64.2"
+#define ECHO_PORT 5683
+#define ECHO_PORT_STR "5683"
+
+// datagrams sent back by the host for every one received, as many as
+// net_ppp.c buffers per socket
+#define UDP_BURST_LEN 4
+#define UDP_DATAGRAM_SIZE 1000
+#define TCP_STREAM_SIZE 8192
+
+#define TIMEOUT_MS 30000
+
+static int pty_master = -1;
+static pid_t pppd_pid = -1;
+static int udp_echo = -1;
+static int tcp_listen = -1;
+static int tcp_echo = -1;
+
+// modem.c stand-ins: the pseudo-terminal plays the UART in PPP data mode
+
+size_t modem_data_mode_read(uint8_t *buf, size_t buf_len) {
+    ssize_t result = read(pty_master, buf, buf_len);
+    return result > 0 ? (size_t) result : 0;
+}
+
+int modem_data_mode_write(const uint8_t *buf, size_t len) {
+    while (len) {
+        ssize_t result = write(pty_master, buf, len);
+        if (result < 0) {
+            if (errno != EAGAIN) {
+                return -1;
+            }
+            poll(&(struct pollfd) { .fd = pty_master, .events = POLLOUT }, 1,
+                 -1);
+            continue;
+        }
+        buf += result;
+        len -= (size_t) result;
+    }
+    return 0;
+}
+
+const modem_socket_stats_t *modem_socket_stats(void) {
+    static const modem_socket_stats_t stats;
+    return &stats;
+}
+
+// lwip_port.c stand-ins
+
+uint32_t lwip_port_rand(void) {
+    return (uint32_t) rand();
+}
+
+u32_t sys_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (u32_t) ((uint64_t) now.tv_sec * 1000
+                    + (uint64_t) now.tv_nsec / 1000000);
+}
+
+static bool timed_out(u32_t start) {
+    return sys_now() - start > TIMEOUT_MS;
+}
+
+static int start_pppd(void) {
+    pty_master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (pty_master < 0 || grantpt(pty_master) || unlockpt(pty_master)) {
+        perror("pty");
+        return -1;
+    }
+    const char *pty_slave = ptsname(pty_master);
+    fcntl(pty_master, F_SETFL, fcntl(pty_master, F_GETFL) | O_NONBLOCK);
+
+    pppd_pid = fork();
+    if (pppd_pid < 0) {
+        perror("fork");
+        return -1;
+    }
+    if (!pppd_pid) {
+        execlp("pppd", "pppd", pty_slave, "115200", "nodetach", "noauth",
+               "local", "nocrtscts", "nodefaultroute", "noccp", "novj",
+               HOST_ADDR ":" CLIENT_ADDR, "ms-dns", HOST_ADDR, "debug",
+               (char *) NULL);
+        perror("pppd");
+        _exit(SKIP);
+    }
+    return 0;
+}
+
+static void stop_pppd(void) {
+    if (pppd_pid > 0) {
+        kill(pppd_pid, SIGTERM);
+        waitpid(pppd_pid, NULL, 0);
+    }
+}
+
+static int start_echo_servers(void) {
+    struct sockaddr_in addr = {
+        .sin_family = AF_INET,
+        .sin_port = htons(ECHO_PORT),
+        .sin_addr.s_addr = htonl(INADDR_ANY)
+    };
+    int reuse = 1;
+    udp_echo = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, 0);
+    tcp_listen = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    if (udp_echo < 0 || tcp_listen < 0
+            || setsockopt(tcp_listen, SOL_SOCKET, SO_REUSEADDR, &reuse,
+                          sizeof(reuse))
+            || bind(udp_echo, (struct sockaddr *) &addr, sizeof(addr))
+            || bind(tcp_listen, (struct sockaddr *) &addr, sizeof(addr))
+            || listen(tcp_listen, 1)) {
+        perror("echo server");
+        return -1;
+    }
+    return 0;
+}
+
+// Serves the host end of the link; called whenever the test waits for
+// net_ppp.c
+static void serve_echo(void) {
+    uint8_t buf[2048];
+    struct sockaddr_in peer;
+    socklen_t peer_len = sizeof(peer);
+    ssize_t len = recvfrom(udp_echo, buf, sizeof(buf), 0,
+                           (struct sockaddr *) &peer, &peer_len);
+    if (len > 0) {
+        for (int i = 0; i < UDP_BURST_LEN; i++) {
+            buf[0] = (uint8_t) i;
+            sendto(udp_echo, buf, (size_t) len, 0, (struct sockaddr *) &peer,
+                   peer_len);
+        }
+    }
+
+    if (tcp_echo < 0) {
+        tcp_echo = accept4(tcp_listen, NULL, NULL, SOCK_NONBLOCK);
+    }
+    if (tcp_echo >= 0 && (len = read(tcp_echo, buf, sizeof(buf))) > 0) {
+        // the client reads slower than the link, so this may block
+        fcntl(tcp_echo, F_SETFL, fcntl(tcp_echo, F_GETFL) & ~O_NONBLOCK);
+        if (write(tcp_echo, buf, (size_t) len) != len) {
+            perror("TCP echo");
+        }
+        fcntl(tcp_echo, F_SETFL, fcntl(tcp_echo, F_GETFL) | O_NONBLOCK);
+    }
+}
+
+static bool pppd_exited(void) {
+    if (pppd_pid > 0 && waitpid(pppd_pid, NULL, WNOHANG) == pppd_pid) {
+        pppd_pid = -1;
+    }
+    return pppd_pid < 0;
+}
+
+static int connect_ctx(anj_net_ctx_t *ctx,
+                       int (*connect)(anj_net_ctx_t *, const char *,
+                                      const char *)) {
+    u32_t start = sys_now();
+    int result;
+    while ((result = connect(ctx, HOST_ADDR, ECHO_PORT_STR))
+            == ANJ_NET_EINPROGRESS) {
+        if (pppd_exited() || timed_out(start)) {
+            fprintf(stderr, "connect timed out\n");
+            return -1;
+        }
+        serve_echo();
+    }
+    return result;
+}
+
+static int test_udp_burst(void) {
+    anj_net_config_t config = { 0 };
+    anj_net_ctx_t *ctx = NULL;
+    if (anj_udp_create_ctx(&ctx, &config)
+            || connect_ctx(ctx, anj_udp_connect)) {
+        fprintf(stderr, "UDP connect failed\n");
+        return -1;
+    }
+
+    uint8_t out[UDP_DATAGRAM_SIZE];
+    for (size_t i = 0; i < sizeof(out); i++) {
+        out[i] = (uint8_t) (i * 7);
+    }
+    size_t sent;
+    if (anj_udp_send(ctx, &sent, out, sizeof(out)) || sent != sizeof(out)) {
+        fprintf(stderr, "UDP send failed\n");
+        return -1;
+    }
+
+    u32_t start = sys_now();
+    int received = 0;
+    while (received < UDP_BURST_LEN) {
+        uint8_t in[UDP_DATAGRAM_SIZE + 1];
+        size_t len;
+        int result = anj_udp_recv(ctx, &len, in, sizeof(in));
+        if (result == ANJ_NET_EAGAIN) {
+            if (timed_out(start)) {
+                fprintf(stderr, "UDP: %d of %d datagrams received\n",
+                        received, UDP_BURST_LEN);
+                return -1;
+            }
+            serve_echo();
+            continue;
+        }
+        if (result || len != sizeof(out) || in[0] != received
+                || memcmp(in + 1, out + 1, sizeof(out) - 1)) {
+            fprintf(stderr, "UDP: datagram %d corrupted\n", received);
+            return -1;
+        }
+        received++;
+    }
+    anj_udp_close(ctx);
+    anj_udp_cleanup_ctx(&ctx);
+    return 0;
+}
+
+static int test_tcp_stream(void) {
+    anj_net_config_t config = { 0 };
+    anj_net_ctx_t *ctx = NULL;
+    if (anj_tcp_create_ctx(&ctx, &config)
+            || connect_ctx(ctx, anj_tcp_connect)) {
+        fprintf(stderr, "TCP connect failed\n");
+        return -1;
+    }
+
+    static uint8_t out[TCP_STREAM_SIZE];
+    static uint8_t in[TCP_STREAM_SIZE];
+    for (size_t i = 0; i < sizeof(out); i++) {
+        out[i] = (uint8_t) (i % 251);
+    }
+    size_t sent = 0;
+    size_t received = 0;
+    u32_t start = sys_now();
+    while (received < sizeof(in)) {
+        if (timed_out(start)) {
+            fprintf(stderr, "TCP: %zu of %zu bytes received\n", received,
+                    sizeof(in));
+            return -1;
+        }
+        size_t len;
+        int result;
+        if (sent < sizeof(out)) {
+            result = anj_tcp_send(ctx, &len, out + sent, sizeof(out) - sent);
+            if (!result) {
+                sent += len;
+            } else if (result != ANJ_NET_EAGAIN) {
+                fprintf(stderr, "TCP send failed\n");
+                return -1;
+            }
+        }
+        result = anj_tcp_recv(ctx, &len, in + received,
+                              sizeof(in) - received);
+        if (!result) {
+            if (!len) {
+                fprintf(stderr, "TCP: connection closed by peer\n");
+                return -1;
+            }
+            received += len;
+        } else if (result != ANJ_NET_EAGAIN) {
+            fprintf(stderr, "TCP recv failed\n");
+            return -1;
+        }
+        serve_echo();
+    }
+    if (memcmp(in, out, sizeof(in))) {
+        fprintf(stderr, "TCP: stream corrupted\n");
+        return -1;
+    }
+    anj_tcp_close(ctx);
+    anj_tcp_cleanup_ctx(&ctx);
+    return 0;
+}
+
+int main(void) {
+    if (geteuid()) {
+        fprintf(stderr, "pppd needs root, skipping\n");
+        return SKIP;
+    }
+    if (start_echo_servers() || start_pppd()) {
+        return SKIP;
+    }
+    int result = test_udp_burst() || test_tcp_stream() ? EXIT_FAILURE
+                                                       : EXIT_SUCCESS;
+    if (pppd_exited()) {
+        // most likely not installed, or with no PPP support in the kernel
+        fprintf(stderr, "pppd exited, skipping\n");
+        return SKIP;
+    }
+    stop_pppd();
+    return result;
+}
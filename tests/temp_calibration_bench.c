@@ -0,0 +1,87 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+/*
+ * Compares the speed of the fixed point conversion in temp_calibration.c with
+ * the calibration formula computed in double and single precision floating
+ * point. The numbers are only indicative of the target, which has a single
+ * precision FPU and does double precision in software; measure there with
+ * CONFIG_PROFILER.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "temp_calibration.h"
+
+#define ROUNDS 64
+
+static const temp_calibration_data_t DATA = { 30, 110, 1040, 1310, 1655 };
+
+// oversampled by 16, the reference reading changing every 64 conversions as
+// the filtered value would
+#define VREF_RAW(I) (1650 * 16 + ((I) >> 6) % 16)
+#define TEMP_RAW(I) (1100 * 16 + (I) % 4096)
+
+static double exact(uint32_t temp_raw, uint32_t vref_raw) {
+    return DATA.cal1_temp
+           + (double) (DATA.cal2_temp - DATA.cal1_temp)
+                     / (DATA.cal2_value - DATA.cal1_value)
+                     * ((double) DATA.vrefint_cal * temp_raw / vref_raw
+                        - DATA.cal1_value);
+}
+
+static float single_precision(uint32_t temp_raw, uint32_t vref_raw) {
+    return (float) DATA.cal1_temp
+           + (float) (DATA.cal2_temp - DATA.cal1_temp)
+                     / (float) (DATA.cal2_value - DATA.cal1_value)
+                     * ((float) DATA.vrefint_cal * (float) temp_raw
+                                / (float) vref_raw
+                        - (float) DATA.cal1_value);
+}
+
+static double now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double) now.tv_sec * 1e9 + (double) now.tv_nsec;
+}
+
+static void report(const char *name, double start, double sum) {
+    printf("%-16s %6.2f ns per conversion (sum %g)\n", name,
+           (now_ns() - start) / (ROUNDS * 65536.0), sum);
+}
+
+int main(void) {
+    temp_calibration_t cal;
+    temp_calibration_init(&cal, &DATA);
+
+    // the sums keep the compiler from optimizing the loops away
+    double start = now_ns();
+    int64_t fixed_sum = 0;
+    for (uint32_t i = 0; i < ROUNDS * 65536; i++) {
+        fixed_sum += temp_calibration_convert(&cal, TEMP_RAW(i), VREF_RAW(i));
+    }
+    report("fixed point", start, (double) fixed_sum / 65536);
+
+    start = now_ns();
+    double double_sum = 0;
+    for (uint32_t i = 0; i < ROUNDS * 65536; i++) {
+        double_sum += exact(TEMP_RAW(i), VREF_RAW(i));
+    }
+    report("double", start, double_sum);
+
+    start = now_ns();
+    float float_sum = 0;
+    for (uint32_t i = 0; i < ROUNDS * 65536; i++) {
+        float_sum += single_precision(TEMP_RAW(i), VREF_RAW(i));
+    }
+    report("float", start, float_sum);
+    return 0;
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright 2025 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay Lite LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay Lite LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+/*
+ * Checks the fixed point conversion in temp_calibration.c against the exact
+ * value of the calibration formula, for every 12-bit sensor reading and every
+ * internal reference reading possible within the allowed analog supply range,
+ * with a few sets of calibration data and oversampling scales.
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "temp_calibration.h"
+
+// bound documented in temp_calibration.c
+#define MAX_ERROR 0.00002
+
+// VREFINT is 1.21 V typical; readings at Vref+ of 3.6 V and 1.62 V
+#define VREF_RAW_MIN 1300
+#define VREF_RAW_MAX 3100
+
+static const temp_calibration_data_t CALIBRATIONS[] = {
+    // typical values
+    { 30, 110, 1040, 1310, 1655 },
+    // extremes of the calibration values
+    { 30, 110, 900, 1050, 1600 },
+    { 30, 110, 1200, 1600, 1700 },
+    // calibration temperatures of other parts of the family
+    { 30, 130, 1000, 1400, 1650 },
+};
+
+// ADC oversampling ratio >> shift; the readings are the sums of this many
+// samples
+static const uint32_t SCALES[] = { 1, 8, 16, 256, 1024 };
+
+static double exact(const temp_calibration_data_t *data,
+                    uint32_t temp_raw,
+                    uint32_t vref_raw) {
+    return data->cal1_temp
+           + (double) (data->cal2_temp - data->cal1_temp)
+                     / (data->cal2_value - data->cal1_value)
+                     * ((double) data->vrefint_cal * temp_raw / vref_raw
+                        - data->cal1_value);
+}
+
+static float single_precision(const temp_calibration_data_t *data,
+                              uint32_t temp_raw,
+                              uint32_t vref_raw) {
+    return (float) data->cal1_temp
+           + (float) (data->cal2_temp - data->cal1_temp)
+                     / (float) (data->cal2_value - data->cal1_value)
+                     * ((float) data->vrefint_cal * (float) temp_raw
+                                / (float) vref_raw
+                        - (float) data->cal1_value);
+}
+
+static int check(const temp_calibration_data_t *data, uint32_t scale) {
+    temp_calibration_t cal;
+    temp_calibration_init(&cal, data);
+    double max_error = 0;
+    double max_float_error = 0;
+    uint32_t seed = 1;
+    for (uint32_t vref = VREF_RAW_MIN; vref <= VREF_RAW_MAX; vref++) {
+        for (uint32_t temp = 0; temp < 4096; temp++) {
+            // oversampled readings aren't multiples of the scale
+            seed = seed * 1103515245 + 12345;
+            uint32_t vref_raw = vref * scale + (seed >> 8) % scale;
+            uint32_t temp_raw = temp * scale + (seed >> 20) % scale;
+
+            double expected = exact(data, temp_raw, vref_raw);
+            double actual =
+                    temp_calibration_convert(&cal, temp_raw, vref_raw)
+                    / 65536.0;
+            max_error = fmax(max_error, fabs(actual - expected));
+            max_float_error =
+                    fmax(max_float_error,
+                         fabs(single_precision(data, temp_raw, vref_raw)
+                              - expected));
+
+            // used for the thresholds, where a small fraction of a step of
+            // the ADC is good enough
+            double back = temp_calibration_to_raw(&cal, expected, vref_raw);
+            if (fabs(back - temp_raw) > 0.001 * scale) {
+                fprintf(stderr, "inverse of %u is %f\n", (unsigned) temp_raw,
+                        back);
+                return -1;
+            }
+        }
+    }
+    printf("CAL1 %u, CAL2 %u, VREFINT_CAL %u, scale %4u: max error %.6f C, "
+           "single precision %.6f C\n",
+           (unsigned) data->cal1_value, (unsigned) data->cal2_value,
+           (unsigned) data->vrefint_cal, (unsigned) scale, max_error,
+           max_float_error);
+    return max_error <= MAX_ERROR ? 0 : -1;
+}
+
+int main(void) {
+    int result = EXIT_SUCCESS;
+    for (size_t i = 0; i < sizeof(CALIBRATIONS) / sizeof(*CALIBRATIONS); i++) {
+        for (size_t j = 0; j < sizeof(SCALES) / sizeof(*SCALES); j++) {
+            if (check(&CALIBRATIONS[i], SCALES[j])) {
+                result = EXIT_FAILURE;
+            }
+        }
+    }
+    return result;
+}